@@ -0,0 +1,136 @@
+#ifndef AGENDA_HPP
+#define AGENDA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "Date.hpp"
+#include "Priority.hpp"
+#include "TaskCategory.hpp"
+
+namespace am {
+    /**
+     * @class Agenda
+     * @brief Ordered view of the tasks of all categories, answering "what do I do next".
+     *
+     * Tasks are kept in a balanced tree ordered by deadline, then by priority (most important
+     * first), then by when-to-do date. Tasks without a valid deadline come last. The order is
+     * maintained incrementally when tasks are added, removed or rescheduled, so reading the
+     * first k entries is O(k) and never re-sorts the whole task set.
+     */
+    class Agenda {
+    public:
+        /**
+         * @struct Entry
+         * @brief The sort key of one task together with the task it belongs to.
+         */
+        struct Entry {
+            /** @brief The deadline of the task. */
+            Date deadline;
+
+            /** @brief The priority of the task. */
+            Priority priority;
+
+            /** @brief The when-to-do date of the task. */
+            Date whenToDo;
+
+            /** @brief The task. */
+            TaskRef task;
+
+            /**
+             * @brief Returns the deadline as a day count for sorting.
+             *
+             * @return The day count, or the largest one if the task has no valid deadline.
+             */
+            int32_t deadlineDays() const {
+                return deadline.isValid() ? deadline.toDays() : INT32_MAX;
+            }
+
+            friend bool operator<(const Entry& lhs, const Entry& rhs) {
+                int32_t lhsDeadline = lhs.deadlineDays();
+                int32_t rhsDeadline = rhs.deadlineDays();
+                if (lhsDeadline != rhsDeadline) {
+                    return lhsDeadline < rhsDeadline;
+                }
+                if (lhs.priority != rhs.priority) {
+                    return lhs.priority > rhs.priority;
+                }
+                if (lhs.whenToDo != rhs.whenToDo) {
+                    return lhs.whenToDo < rhs.whenToDo;
+                }
+                return lhs.task < rhs.task;
+            }
+        };
+
+        /**
+         * @brief Adds a task to the agenda.
+         *
+         * @param entry The sort key and reference of the task.
+         */
+        void add(const Entry& entry) {
+            entries.insert(entry);
+        }
+
+        /**
+         * @brief Removes a task from the agenda.
+         *
+         * @param entry The entry the task was added with.
+         * @return True if the task was found, false otherwise.
+         */
+        bool remove(const Entry& entry) {
+            return entries.erase(entry) > 0;
+        }
+
+        /**
+         * @brief Moves a task to a new when-to-do date.
+         *
+         * @param entry The entry the task is currently stored with.
+         * @param whenToDo The new when-to-do date.
+         */
+        void reschedule(const Entry& entry, Date whenToDo) {
+            if (remove(entry)) {
+                Entry moved = entry;
+                moved.whenToDo = whenToDo;
+                add(moved);
+            }
+        }
+
+        /**
+         * @brief Returns the first tasks of the agenda.
+         *
+         * @param count The maximum number of tasks to return.
+         * @return Up to `count` entries in agenda order.
+         */
+        std::vector<Entry> top(size_t count) const {
+            std::vector<Entry> result;
+            result.reserve(count < entries.size() ? count : entries.size());
+            for (auto entry = entries.begin(); entry != entries.end() && result.size() < count; ++entry) {
+                result.push_back(*entry);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the number of tasks on the agenda.
+         *
+         * @return The number of entries.
+         */
+        size_t size() const {
+            return entries.size();
+        }
+
+        /**
+         * @brief Removes all tasks from the agenda.
+         */
+        void clear() {
+            entries.clear();
+        }
+
+    private:
+        /** @brief All entries in agenda order. */
+        std::set<Entry> entries;
+    };
+}
+
+#endif
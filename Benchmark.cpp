@@ -0,0 +1,455 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Benchmark for the load, filter, render, reschedule, mark-done (synchronous and
+ * asynchronous), edit, compaction and append paths, for full-text searches, for date queries
+ * from several threads through the `TaskEngine` and for tasks added by several threads through
+ * the `TaskIngestor`.
+ *
+ * The benchmark generates synthetic study.txt, life.txt and work.txt files of a given size in a
+ * scratch directory and times the main operations of the task engine on them. For every
+ * operation it reports the throughput, the number of heap allocations and the peak resident
+ * set size of the process.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "TaskEngine.hpp"
+#include "TaskIngestor.hpp"
+#include "TaskRepository.hpp"
+using namespace am;
+
+namespace {
+    /** @brief Number of heap allocations since the program started. */
+    std::atomic<size_t> allocationCount{0};
+
+    /** @brief Number of heap bytes requested since the program started. */
+    std::atomic<size_t> allocatedBytes{0};
+}
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// Kept out of line so GCC does not pair the inlined free() with the counting operator new.
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief The date every generated workload treats as "today".
+ */
+const Date BENCHMARK_TODAY = Date::fromCivil(2025, 1, 15);
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ *
+ * @return Peak RSS in mebibytes.
+ */
+double peakRssMiB() {
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+}
+
+/**
+ * @class Measurement
+ * @brief Times one benchmark step and prints a result line for it.
+ */
+class Measurement {
+public:
+
+    /**
+     * @brief Starts measuring a step.
+     *
+     * @param name The name printed for the step.
+     */
+    explicit Measurement(const std::string& name)
+        : name(name),
+          allocationsAtStart(allocationCount.load()),
+          start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Stops the measurement and prints the result.
+     *
+     * @param operations Number of rows or operations processed by the step.
+     * @param unit The unit of `operations` (e.g. "rows", "ops").
+     */
+    void report(size_t operations, const char* unit) const {
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        size_t allocations = allocationCount.load() - allocationsAtStart;
+
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << std::setw(11) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms"
+                  << std::setw(14) << std::setprecision(0) << (seconds > 0.0 ? operations / seconds : 0.0)
+                  << " " << unit << "/s"
+                  << std::setw(12) << allocations << " allocs"
+                  << std::setw(10) << std::setprecision(1) << peakRssMiB() << " MiB peak\n";
+    }
+
+private:
+    /** @brief The name printed for the step. */
+    std::string name;
+
+    /** @brief Allocation counter when the step started. */
+    size_t allocationsAtStart;
+
+    /** @brief When the step started. */
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief Writes synthetic task files with the given number of lines each.
+ *
+ * Dates are spread over 60 days around `BENCHMARK_TODAY`, subjects, assignees and priorities are
+ * drawn from small sets, and fields use the same padding as the hand-written files.
+ *
+ * @param lines Number of records per category file.
+ * @param seed Seed of the random generator.
+ */
+void generateFiles(size_t lines, unsigned seed) {
+    static const char* subjects[] = {"math", "MATH", "FIZYKA", "Chemistry", "JPO", "History"};
+    static const char* assignees[] = {"Amir", "Pavel", "Olga", "Jan", "Marta"};
+    static const char* priorities[] = {"low", "medium", "high"};
+
+    std::mt19937 random(seed);
+    std::ofstream study(StudyTask::FILE_PATH, std::ios::trunc);
+    std::ofstream life(LifeTask::FILE_PATH, std::ios::trunc);
+    std::ofstream work(WorkTask::FILE_PATH, std::ios::trunc);
+
+    for (size_t i = 0; i < lines; ++i) {
+        std::string whenToDo = BENCHMARK_TODAY.addDays(static_cast<int32_t>(random() % 60) - 30).toString();
+        std::string deadline = BENCHMARK_TODAY.addDays(static_cast<int32_t>(random() % 60) - 20).toString();
+        const char* priority = priorities[random() % 3];
+
+        study << subjects[random() % 6] << ",   Study task " << i << ",   " << whenToDo << ",   "
+              << deadline << ",   " << priority << "\n";
+        life << "Life task " << i << ",    " << whenToDo << ",    " << deadline << ",    " << priority << "\n";
+        work << assignees[random() % 5] << ",  Work task " << i << ",  " << whenToDo << ",  "
+             << deadline << ",  " << priority << "\n";
+    }
+}
+
+/**
+ * @brief Runs all benchmark steps on files of one size.
+ *
+ * @param lines Number of records per category file.
+ */
+void runBenchmark(size_t lines) {
+    const size_t markDoneCount = 100;
+    const size_t appendCount = 1000;
+    const size_t queryThreads = 4;
+    const size_t queriesPerThread = 1000;
+    const size_t searchCount = 1000;
+
+    std::cout << "\n" << lines << " lines per category\n";
+    std::remove(TaskJournal::FILE_PATH);
+    generateFiles(lines, 42);
+
+    {
+        TaskStorage storage;
+        TaskTable<StudyTask> study;
+        TaskTable<LifeTask> life;
+        TaskTable<WorkTask> work;
+
+        Measurement measurement("loadTasks<StudyTask>");
+        storage.loadTasks(StudyTask::FILE_PATH, study);
+        measurement.report(lines, "rows");
+
+        Measurement lifeMeasurement("loadTasks<LifeTask>");
+        storage.loadTasks(LifeTask::FILE_PATH, life);
+        lifeMeasurement.report(lines, "rows");
+
+        Measurement workMeasurement("loadTasks<WorkTask>");
+        storage.loadTasks(WorkTask::FILE_PATH, work);
+        workMeasurement.report(lines, "rows");
+    }
+
+    {
+        TaskStorage storage;
+        TaskTable<StudyTask> study;
+        TaskTable<LifeTask> life;
+        TaskTable<WorkTask> work;
+        ThreadPool pool;
+
+        Measurement measurement("loadTasks parallel (3 files)");
+        auto pendingStudy = storage.startLoad<StudyTask>(StudyTask::FILE_PATH, pool);
+        auto pendingLife = storage.startLoad<LifeTask>(LifeTask::FILE_PATH, pool);
+        auto pendingWork = storage.startLoad<WorkTask>(WorkTask::FILE_PATH, pool);
+        storage.finishLoad(pendingStudy, study);
+        storage.finishLoad(pendingLife, life);
+        storage.finishLoad(pendingWork, work);
+        measurement.report(3 * lines, "rows");
+    }
+
+    {
+        // The first load writes the snapshots, the second one reads them.
+        TaskRepository writer;
+        writer.setSnapshots(true);
+        writer.ensureLoaded();
+
+        TaskRepository reader;
+        reader.setSnapshots(true);
+        Measurement measurement("repository load (snapshot)");
+        reader.ensureLoaded();
+        measurement.report(3 * lines, "rows");
+    }
+
+    {
+        TaskEngine engine;
+        engine.load();
+
+        Measurement measurement("engine queries (4 threads)");
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < queryThreads; ++thread) {
+            threads.emplace_back([&engine, queriesPerThread] {
+                for (size_t i = 0; i < queriesPerThread; ++i) {
+                    engine.findTasksForDate(BENCHMARK_TODAY.addDays(static_cast<int32_t>(i % 30) - 15));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        measurement.report(queryThreads * queriesPerThread, "queries");
+    }
+
+    TaskRepository repository;
+    {
+        Measurement measurement("repository load + index");
+        repository.ensureLoaded();
+        measurement.report(3 * lines, "rows");
+    }
+
+    {
+        Measurement measurement("today filter (3 categories)");
+        size_t found = repository.getTasksForDate<StudyTask>(BENCHMARK_TODAY).size()
+            + repository.getTasksForDate<LifeTask>(BENCHMARK_TODAY).size()
+            + repository.getTasksForDate<WorkTask>(BENCHMARK_TODAY).size();
+        measurement.report(found, "tasks");
+    }
+
+    {
+        // Formats every task of the day into one frame, as the console does for a single page.
+        Frame frame;
+        Measurement measurement("render today (frame)");
+        const std::vector<TaskRef>& today = repository.findTasksForDate(BENCHMARK_TODAY);
+        for (const TaskRef& task : today) {
+            switch (task.category) {
+                case TaskCategory::Study:
+                    repository.getTasks<StudyTask>().get(task.id).render(frame);
+                    break;
+                case TaskCategory::Life:
+                    repository.getTasks<LifeTask>().get(task.id).render(frame);
+                    break;
+                case TaskCategory::Work:
+                    repository.getTasks<WorkTask>().get(task.id).render(frame);
+                    break;
+            }
+        }
+        measurement.report(today.size(), "tasks");
+    }
+
+    {
+        Measurement measurement("search index build");
+        repository.buildSearchIndex();
+        measurement.report(3 * lines, "rows");
+    }
+
+    {
+        // Both words are common; the task number is the rare word the others are checked against.
+        size_t found = 0;
+        Measurement measurement("search (3 words)");
+        for (size_t i = 0; i < searchCount; ++i) {
+            found += repository.search("work TASK " + std::to_string(i * lines / searchCount)).size();
+        }
+        measurement.report(searchCount, "queries");
+        std::cout << "    " << found << " matches\n";
+    }
+
+    {
+        size_t found = 0;
+        Measurement measurement("search (name + prefix)");
+        for (size_t i = 0; i < searchCount; ++i) {
+            found += repository.search("olga " + std::to_string(i % 100 + 100) + "*").size();
+        }
+        measurement.report(searchCount, "queries");
+        std::cout << "    " << found << " matches\n";
+    }
+
+    {
+        Measurement measurement("rescheduleTasks");
+        size_t moved = 0;
+        repository.rescheduleTasks(BENCHMARK_TODAY, BENCHMARK_TODAY.nextDay(), moved);
+        measurement.report(moved, "tasks");
+    }
+
+    {
+        std::vector<TaskId> ids = repository.getTasks<WorkTask>().liveIds();
+        size_t count = std::min(markDoneCount, ids.size());
+
+        Measurement measurement("markTaskAsDone");
+        for (size_t i = 0; i < count; ++i) {
+            repository.removeTask<WorkTask>(ids[i * (ids.size() / count)]);
+        }
+        measurement.report(count, "ops");
+    }
+
+    {
+        // Only the time the caller waits is measured; the I/O thread finishes before the next step.
+        std::vector<TaskId> ids = repository.getTasks<LifeTask>().liveIds();
+        size_t count = std::min(markDoneCount, ids.size());
+        repository.setAsyncWrites(true);
+
+        Measurement measurement("markTaskAsDone (async)");
+        for (size_t i = 0; i < count; ++i) {
+            repository.removeTask<LifeTask>(ids[i * (ids.size() / count)]);
+        }
+        measurement.report(count, "ops");
+        repository.setAsyncWrites(false);
+    }
+
+    {
+        std::vector<TaskId> ids = repository.getTasks<StudyTask>().liveIds();
+        size_t count = std::min(markDoneCount, ids.size());
+
+        Measurement measurement("updateTask + flushChanges");
+        for (size_t i = 0; i < count; ++i) {
+            TaskId id = ids[i * (ids.size() / count)];
+            StudyTask task = repository.getTasks<StudyTask>().get(id);
+            task.setPriority(Priority::High);
+            task.setDescription(task.getDescription() + " (edited)");
+            repository.updateTask(id, task);
+        }
+        repository.flushChanges();
+        measurement.report(count, "ops");
+    }
+
+    {
+        // Changes only append to the journal; folding it into the files is a separate step.
+        Measurement measurement("journal compaction");
+        repository.compact();
+        measurement.report(1, "ops");
+    }
+
+    {
+        Measurement measurement("createLifeTask append");
+        for (size_t i = 0; i < appendCount; ++i) {
+            LifeTask task("Appended task " + std::to_string(i), BENCHMARK_TODAY, BENCHMARK_TODAY.addDays(7), Priority::Low);
+            repository.addTask(task);
+        }
+        measurement.report(appendCount, "ops");
+    }
+
+    {
+        TaskEngine engine;
+        engine.load();
+        IngestStats stats;
+
+        Measurement measurement("ingest queue (4 producers)");
+        {
+            TaskIngestor ingestor(engine);
+            std::vector<std::thread> producers;
+            for (size_t thread = 0; thread < queryThreads; ++thread) {
+                producers.emplace_back([&ingestor, thread, appendCount, queryThreads] {
+                    for (size_t i = thread; i < appendCount; i += queryThreads) {
+                        ingestor.submit(LifeTask("Ingested task " + std::to_string(i), BENCHMARK_TODAY,
+                            BENCHMARK_TODAY.addDays(7), Priority::Low));
+                    }
+                });
+            }
+            for (std::thread& producer : producers) {
+                producer.join();
+            }
+            ingestor.waitUntilCommitted();
+            stats = ingestor.getStats();
+        }
+        measurement.report(appendCount, "ops");
+        std::cout << "    " << stats.batches << " batches, " << std::setprecision(1) << stats.averageBatchSize()
+                  << " tasks avg, " << stats.maxBatchSize << " max, queue depth " << stats.maxQueueDepth
+                  << " max, commit " << std::setprecision(3) << stats.averageCommitMs() << " ms avg, "
+                  << stats.maxCommitMs << " ms max\n";
+    }
+}
+
+/**
+ * @brief Parses a comma-separated list of sizes such as "1000,10000".
+ *
+ * @param text The list to parse.
+ * @return The sizes.
+ */
+std::vector<size_t> parseSizes(const std::string& text) {
+    std::vector<size_t> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        sizes.push_back(static_cast<size_t>(std::stoull(item)));
+    }
+    return sizes;
+}
+
+/**
+ * @brief Entry point of the benchmark.
+ *
+ * Usage: `TaskBenchmark [--sizes 1000,10000,...] [--dir scratch-directory]`. The scratch
+ * directory is created if needed and its task files are overwritten.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments.
+ * @return int Exit status.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+    std::string directory = "benchmark_data";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--sizes" && i + 1 < argc) {
+            sizes = parseSizes(argv[++i]);
+        } else if (argument == "--dir" && i + 1 < argc) {
+            directory = argv[++i];
+        } else {
+            std::cerr << "Usage: TaskBenchmark [--sizes 1000,10000,...] [--dir scratch-directory]\n";
+            return 2;
+        }
+    }
+
+    mkdir(directory.c_str(), 0755);
+    if (chdir(directory.c_str()) != 0) {
+        std::cerr << "Error: Could not use directory: " << directory << "\n";
+        return 1;
+    }
+
+    std::cout << "Tokenizer: " << DelimiterScanner::implementation() << "\n";
+    for (size_t lines : sizes) {
+        runBenchmark(lines);
+    }
+    return 0;
+}
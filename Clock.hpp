@@ -0,0 +1,110 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <ctime>
+#include "Date.hpp"
+
+namespace am {
+    /**
+     * @class Clock
+     * @brief Calendar service that answers "what day is today".
+     *
+     * The local date is computed once and cached until the next local midnight, so repeated
+     * calls to `today()` cost a single `time()` call and an integer comparison. The clock can be
+     * pinned to a fixed point in time, which makes benchmarks and tests deterministic.
+     */
+    class Clock {
+    public:
+
+        /**
+         * @brief Default constructor for a clock that follows the system time.
+         */
+        Clock() = default;
+
+        /**
+         * @brief Creates a clock pinned to a fixed point in time.
+         *
+         * @param fixedTime The time the clock should report.
+         */
+        explicit Clock(time_t fixedTime) {
+            setFixedTime(fixedTime);
+        }
+
+        /**
+         * @brief Returns the current local date.
+         *
+         * The date is recomputed only after the cached value has expired at midnight.
+         *
+         * @return Today's date.
+         */
+        Date today() {
+            time_t current = now();
+            if (!cachedToday.isValid() || current >= validUntil || current < validFrom) {
+                refresh(current);
+            }
+            return cachedToday;
+        }
+
+        /**
+         * @brief Returns the current time as seen by this clock.
+         *
+         * @return The fixed time if one is set, the system time otherwise.
+         */
+        time_t now() const {
+            return fixed ? fixedTime : time(0);
+        }
+
+        /**
+         * @brief Pins the clock to a fixed point in time.
+         *
+         * @param time The time the clock should report from now on.
+         */
+        void setFixedTime(time_t time) {
+            fixed = true;
+            fixedTime = time;
+            cachedToday = Date();
+        }
+
+        /**
+         * @brief Makes the clock follow the system time again.
+         */
+        void clearFixedTime() {
+            fixed = false;
+            cachedToday = Date();
+        }
+
+    private:
+        /** @brief Whether the clock reports `fixedTime` instead of the system time. */
+        bool fixed = false;
+
+        /** @brief The time reported while the clock is fixed. */
+        time_t fixedTime = 0;
+
+        /** @brief The cached local date. */
+        Date cachedToday;
+
+        /** @brief Start of the day held in `cachedToday` (local midnight). */
+        time_t validFrom = 0;
+
+        /** @brief Start of the following day; the cache expires at this time. */
+        time_t validUntil = 0;
+
+        void refresh(time_t current) {
+            tm local = {};
+            localtime_r(&current, &local);
+            cachedToday = Date::fromTm(local);
+
+            local.tm_hour = 0;
+            local.tm_min = 0;
+            local.tm_sec = 0;
+            local.tm_isdst = -1;
+            validFrom = mktime(&local);
+
+            local.tm_mday += 1;
+            local.tm_isdst = -1;
+            validUntil = mktime(&local);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef DATE_HPP
+#define DATE_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace am {
+    /**
+     * @class Date
+     * @brief Compact calendar date stored as a number of days since 01.01.1970.
+     *
+     * A `Date` is a single 32-bit integer, so it is trivially copyable and can be compared,
+     * incremented and range-checked without touching the heap. It is parsed from and formatted
+     * to the "DD.MM.YYYY" text used in the task files. A default-constructed date is invalid,
+     * which is used for missing or malformed dates.
+     */
+    class Date {
+    public:
+        /** @brief Length of a date in "DD.MM.YYYY" format. */
+        static constexpr size_t TEXT_LENGTH = 10;
+
+        /**
+         * @brief Default constructor for creating an invalid date.
+         */
+        constexpr Date() : days(INVALID_DAYS) {}
+
+        /**
+         * @brief Creates a date from a day number.
+         *
+         * @param days The number of days since 01.01.1970.
+         * @return The corresponding date.
+         */
+        static constexpr Date fromDays(int32_t days) {
+            return Date(days);
+        }
+
+        /**
+         * @brief Creates a date from a calendar day.
+         *
+         * @param year The year (e.g. 2025).
+         * @param month The month (1-12).
+         * @param day The day of the month (1-31).
+         * @return The corresponding date, or an invalid date if the day does not exist.
+         */
+        static constexpr Date fromCivil(int year, int month, int day) {
+            if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+                return Date();
+            }
+
+            // Days-from-civil algorithm on a calendar whose years start in March.
+            const int y = year - (month <= 2 ? 1 : 0);
+            const int era = (y >= 0 ? y : y - 399) / 400;
+            const int yearOfEra = y - era * 400;
+            const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+            const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return Date(era * 146097 + dayOfEra - 719468);
+        }
+
+        /**
+         * @brief Creates a date from a `std::tm` broken-down time.
+         *
+         * @param time The broken-down time, e.g. as returned by `localtime`.
+         * @return The corresponding date.
+         */
+        static Date fromTm(const std::tm& time) {
+            return fromCivil(time.tm_year + 1900, time.tm_mon + 1, time.tm_mday);
+        }
+
+        /**
+         * @brief Parses a date in "DD.MM.YYYY" format.
+         *
+         * Leading and trailing spaces are ignored. No heap allocation is performed.
+         *
+         * @param text The text to parse.
+         * @param date Receives the parsed date on success.
+         * @return True if `text` contains a valid date, false otherwise.
+         */
+        static bool parse(std::string_view text, Date& date) {
+            while (!text.empty() && isSpace(text.front())) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && isSpace(text.back())) {
+                text.remove_suffix(1);
+            }
+
+            if (text.size() != TEXT_LENGTH || text[2] != '.' || text[5] != '.') {
+                return false;
+            }
+
+            int day = 0, month = 0, year = 0;
+            if (!readDigits(text.substr(0, 2), day) ||
+                !readDigits(text.substr(3, 2), month) ||
+                !readDigits(text.substr(6, 4), year)) {
+                return false;
+            }
+
+            date = fromCivil(year, month, day);
+            return date.isValid();
+        }
+
+        /**
+         * @brief Parses a date in "DD.MM.YYYY" format.
+         *
+         * @param text The text to parse.
+         * @return The parsed date, or an invalid date if `text` is malformed.
+         */
+        static Date fromString(std::string_view text) {
+            Date date;
+            return parse(text, date) ? date : Date();
+        }
+
+        /**
+         * @brief Checks whether the date holds a real calendar day.
+         *
+         * @return True for a valid date, false for a default-constructed or unparsable one.
+         */
+        constexpr bool isValid() const {
+            return days != INVALID_DAYS;
+        }
+
+        /**
+         * @brief Returns the underlying day number.
+         *
+         * @return The number of days since 01.01.1970.
+         */
+        constexpr int32_t toDays() const {
+            return days;
+        }
+
+        /**
+         * @brief Returns the date a given number of days later.
+         *
+         * @param count The number of days to add (may be negative).
+         * @return The shifted date, or an invalid date if this date is invalid.
+         */
+        constexpr Date addDays(int32_t count) const {
+            return isValid() ? Date(days + count) : Date();
+        }
+
+        /**
+         * @brief Returns the following day.
+         *
+         * @return The next day's date.
+         */
+        constexpr Date nextDay() const {
+            return addDays(1);
+        }
+
+        /**
+         * @brief Checks whether the date lies in an inclusive range.
+         *
+         * @param first The first day of the range.
+         * @param last The last day of the range.
+         * @return True if `first <= *this <= last`.
+         */
+        constexpr bool isBetween(Date first, Date last) const {
+            return isValid() && first.days <= days && days <= last.days;
+        }
+
+        /**
+         * @brief Writes the date in "DD.MM.YYYY" format.
+         *
+         * @param buffer Output buffer with room for at least `TEXT_LENGTH` characters.
+         * @return The number of characters written (0 for an invalid date).
+         */
+        size_t format(char* buffer) const {
+            if (!isValid()) {
+                return 0;
+            }
+
+            int year = 0, month = 0, day = 0;
+            toCivil(year, month, day);
+
+            buffer[0] = static_cast<char>('0' + day / 10);
+            buffer[1] = static_cast<char>('0' + day % 10);
+            buffer[2] = '.';
+            buffer[3] = static_cast<char>('0' + month / 10);
+            buffer[4] = static_cast<char>('0' + month % 10);
+            buffer[5] = '.';
+            buffer[6] = static_cast<char>('0' + year / 1000 % 10);
+            buffer[7] = static_cast<char>('0' + year / 100 % 10);
+            buffer[8] = static_cast<char>('0' + year / 10 % 10);
+            buffer[9] = static_cast<char>('0' + year % 10);
+            return TEXT_LENGTH;
+        }
+
+        /**
+         * @brief Converts the date to a "DD.MM.YYYY" string.
+         *
+         * @return The formatted date, or an empty string for an invalid date.
+         */
+        std::string toString() const {
+            char buffer[TEXT_LENGTH];
+            return std::string(buffer, format(buffer));
+        }
+
+        /**
+         * @brief Splits the date into year, month and day.
+         *
+         * @param year Receives the year.
+         * @param month Receives the month (1-12).
+         * @param day Receives the day of the month (1-31).
+         */
+        constexpr void toCivil(int& year, int& month, int& day) const {
+            // Civil-from-days, the inverse of fromCivil().
+            const int z = days + 719468;
+            const int era = (z >= 0 ? z : z - 146096) / 146097;
+            const int dayOfEra = z - era * 146097;
+            const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            const int mp = (5 * dayOfYear + 2) / 153;
+
+            day = dayOfYear - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+        }
+
+        friend constexpr bool operator==(Date lhs, Date rhs) { return lhs.days == rhs.days; }
+        friend constexpr bool operator!=(Date lhs, Date rhs) { return lhs.days != rhs.days; }
+        friend constexpr bool operator<(Date lhs, Date rhs) { return lhs.days < rhs.days; }
+        friend constexpr bool operator<=(Date lhs, Date rhs) { return lhs.days <= rhs.days; }
+        friend constexpr bool operator>(Date lhs, Date rhs) { return lhs.days > rhs.days; }
+        friend constexpr bool operator>=(Date lhs, Date rhs) { return lhs.days >= rhs.days; }
+
+        /**
+         * @brief Overloads the output stream operator to print the date as "DD.MM.YYYY".
+         *
+         * @param os The output stream.
+         * @param date The date to print.
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& os, Date date) {
+            char buffer[TEXT_LENGTH];
+            return os.write(buffer, static_cast<std::streamsize>(date.format(buffer)));
+        }
+
+    private:
+        /** @brief Sentinel day number used for invalid dates. */
+        static constexpr int32_t INVALID_DAYS = std::numeric_limits<int32_t>::min();
+
+        /** @brief Number of days since 01.01.1970. */
+        int32_t days;
+
+        explicit constexpr Date(int32_t days) : days(days) {}
+
+        static constexpr bool isLeapYear(int year) {
+            return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        }
+
+        static constexpr int daysInMonth(int year, int month) {
+            constexpr int lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+            return month == 2 && isLeapYear(year) ? 29 : lengths[month - 1];
+        }
+
+        static constexpr bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        static bool readDigits(std::string_view digits, int& value) {
+            value = 0;
+            for (char c : digits) {
+                if (c < '0' || c > '9') {
+                    return false;
+                }
+                value = value * 10 + (c - '0');
+            }
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef DATE_INDEX_HPP
+#define DATE_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Date.hpp"
+#include "TaskCategory.hpp"
+
+namespace am {
+    /**
+     * @class DateIndex
+     * @brief Ordered index from a when-to-do date to the tasks scheduled on it.
+     *
+     * The index keeps one bucket per date in a balanced tree, so finding the tasks of one day
+     * is O(log n) and a date range is a contiguous walk over the buckets. Every bucket is kept
+     * sorted by category and id, which is the order the tasks appear in their files. The index
+     * is updated incrementally when tasks are added, removed or rescheduled, and can optionally
+     * be saved next to the task files and reused while those files are unchanged.
+     */
+    class DateIndex {
+    public:
+        /**
+         * @struct FileSignature
+         * @brief Size and modification time of one data file, used to detect stale index files.
+         */
+        struct FileSignature {
+            /** @brief File size in bytes, or -1 if the file does not exist. */
+            int64_t size = -1;
+
+            /** @brief Modification time in nanoseconds since the epoch. */
+            int64_t modified = 0;
+
+            /**
+             * @brief Reads the signature of a file.
+             *
+             * @param filePath The path of the file.
+             * @return The file's signature; a missing file has size -1.
+             */
+            static FileSignature of(const std::string& filePath) {
+                FileSignature signature;
+                struct stat info;
+                if (stat(filePath.c_str(), &info) == 0) {
+                    signature.size = static_cast<int64_t>(info.st_size);
+#ifdef __APPLE__
+                    const timespec& modified = info.st_mtimespec;
+#else
+                    const timespec& modified = info.st_mtim;
+#endif
+                    signature.modified = static_cast<int64_t>(modified.tv_sec) * 1000000000
+                        + static_cast<int64_t>(modified.tv_nsec);
+                }
+                return signature;
+            }
+
+            friend bool operator==(const FileSignature& lhs, const FileSignature& rhs) {
+                return lhs.size == rhs.size && lhs.modified == rhs.modified;
+            }
+        };
+
+        /** @brief Signatures of all data files an index was built from. */
+        using Signature = std::vector<FileSignature>;
+
+        /**
+         * @brief Adds a task to the bucket of a date.
+         *
+         * @param date The when-to-do date of the task.
+         * @param task The task to add.
+         */
+        void add(Date date, TaskRef task) {
+            std::vector<TaskRef>& bucket = buckets[date];
+            bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), task), task);
+            ++entries;
+        }
+
+        /**
+         * @brief Removes a task from the bucket of a date.
+         *
+         * @param date The when-to-do date the task was indexed under.
+         * @param task The task to remove.
+         * @return True if the task was found, false otherwise.
+         */
+        bool remove(Date date, TaskRef task) {
+            auto found = buckets.find(date);
+            if (found == buckets.end()) {
+                return false;
+            }
+
+            std::vector<TaskRef>& bucket = found->second;
+            auto position = std::lower_bound(bucket.begin(), bucket.end(), task);
+            if (position == bucket.end() || *position != task) {
+                return false;
+            }
+
+            bucket.erase(position);
+            if (bucket.empty()) {
+                buckets.erase(found);
+            }
+            --entries;
+            return true;
+        }
+
+        /**
+         * @brief Moves a task from one date to another.
+         *
+         * @param task The task to move.
+         * @param from The date the task is currently indexed under.
+         * @param to The new date.
+         */
+        void move(TaskRef task, Date from, Date to) {
+            if (remove(from, task)) {
+                add(to, task);
+            }
+        }
+
+        /**
+         * @brief Returns the tasks scheduled on a date.
+         *
+         * @param date The date to look up.
+         * @return The tasks of that day, ordered by category and id.
+         */
+        const std::vector<TaskRef>& find(Date date) const {
+            static const std::vector<TaskRef> none;
+            auto found = buckets.find(date);
+            return found != buckets.end() ? found->second : none;
+        }
+
+        /**
+         * @brief Returns the tasks scheduled within a date range.
+         *
+         * @param first The first day of the range.
+         * @param last The last day of the range (inclusive).
+         * @return The tasks of the range, ordered by date, then category and id.
+         */
+        std::vector<TaskRef> findRange(Date first, Date last) const {
+            std::vector<TaskRef> result;
+            for (auto it = buckets.lower_bound(first); it != buckets.end() && it->first <= last; ++it) {
+                result.insert(result.end(), it->second.begin(), it->second.end());
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the number of indexed tasks.
+         *
+         * @return The number of entries.
+         */
+        size_t size() const {
+            return entries;
+        }
+
+        /**
+         * @brief Removes all entries.
+         */
+        void clear() {
+            buckets.clear();
+            entries = 0;
+        }
+
+        /**
+         * @brief Writes the index to a file.
+         *
+         * The index is written to a temporary file that is synced and then renamed over
+         * `filePath`, so a crash or a full disk leaves the previous index file in place.
+         *
+         * @param filePath The path of the index file.
+         * @param signature The signatures of the data files the index describes.
+         * @return True if the file was written, false otherwise.
+         */
+        bool save(const std::string& filePath, const Signature& signature) const {
+            std::string temporary = filePath + ".tmp" + std::to_string(getpid());
+            if (!writeFile(temporary, signature) || !syncFile(temporary)
+                    || std::rename(temporary.c_str(), filePath.c_str()) != 0) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Replaces the index with the contents of an index file.
+         *
+         * The file is only accepted if it was written for data files with exactly the given
+         * signatures; otherwise the index is left empty and must be rebuilt.
+         *
+         * @param filePath The path of the index file.
+         * @param signature The current signatures of the data files.
+         * @return True if the index was loaded, false if the file is missing, stale or corrupt.
+         */
+        bool load(const std::string& filePath, const Signature& signature) {
+            clear();
+
+            std::ifstream file(filePath, std::ios::binary);
+            uint32_t magic = 0, version = 0, files = 0;
+            if (!readValue(file, magic) || magic != MAGIC ||
+                !readValue(file, version) || version != VERSION ||
+                !readValue(file, files) || files != signature.size()) {
+                return false;
+            }
+
+            for (const FileSignature& expected : signature) {
+                FileSignature stored;
+                if (!readValue(file, stored.size) || !readValue(file, stored.modified) || !(stored == expected)) {
+                    return false;
+                }
+            }
+
+            uint64_t count = 0;
+            if (!readValue(file, count)) {
+                return false;
+            }
+
+            for (uint64_t i = 0; i < count; ++i) {
+                int32_t days = 0;
+                uint8_t category = 0;
+                TaskId id = 0;
+                if (!readValue(file, days) || !readValue(file, category) || !readValue(file, id)
+                    || category >= TASK_CATEGORY_COUNT) {
+                    clear();
+                    return false;
+                }
+                // Entries are stored in index order, so appending keeps every bucket sorted.
+                buckets[Date::fromDays(days)].push_back(TaskRef{static_cast<TaskCategory>(category), id});
+                ++entries;
+            }
+            return true;
+        }
+
+    private:
+        /** @brief File magic "AMDI". */
+        static constexpr uint32_t MAGIC = 0x49444D41;
+
+        /** @brief Version of the index file layout. */
+        static constexpr uint32_t VERSION = 1;
+
+        /** @brief Task buckets keyed by when-to-do date. */
+        std::map<Date, std::vector<TaskRef>> buckets;
+
+        /** @brief Total number of indexed tasks. */
+        size_t entries = 0;
+
+        bool writeFile(const std::string& filePath, const Signature& signature) const {
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            writeValue(file, MAGIC);
+            writeValue(file, VERSION);
+            writeValue(file, static_cast<uint32_t>(signature.size()));
+            for (const FileSignature& fileSignature : signature) {
+                writeValue(file, fileSignature.size);
+                writeValue(file, fileSignature.modified);
+            }
+
+            writeValue(file, static_cast<uint64_t>(entries));
+            for (const auto& bucket : buckets) {
+                for (const TaskRef& task : bucket.second) {
+                    writeValue(file, bucket.first.toDays());
+                    writeValue(file, static_cast<uint8_t>(task.category));
+                    writeValue(file, task.id);
+                }
+            }
+            file.close();
+            return static_cast<bool>(file);
+        }
+
+        static bool syncFile(const std::string& filePath) {
+            // The stream gives no access to its descriptor, so the written file is reopened.
+            int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return false;
+            }
+            bool synced = fsync(fd) == 0;
+            ::close(fd);
+            return synced;
+        }
+
+        template <typename V>
+        static void writeValue(std::ofstream& file, const V& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename V>
+        static bool readValue(std::ifstream& file, V& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef DELIMITER_SCANNER_HPP
+#define DELIMITER_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace am {
+    /**
+     * @class DelimiterScanner
+     * @brief Vectorized search primitives for the comma-separated task record format.
+     *
+     * The scanner finds the next field delimiter (comma or newline) and skips the space padding
+     * in front of a field 32 bytes at a time with AVX2 or 16 bytes at a time with SSE2. The
+     * remaining bytes of a buffer, and builds without those instruction sets, use a scalar
+     * fallback with identical results.
+     */
+    class DelimiterScanner {
+    public:
+
+        /**
+         * @brief Finds the first comma or newline in a range.
+         *
+         * @param position Start of the range.
+         * @param end End of the range.
+         * @return Pointer to the first ',' or '\n', or `end` if there is none.
+         */
+        static const char* findDelimiter(const char* position, const char* end) {
+#if defined(__AVX2__)
+            const __m256i comma = _mm256_set1_epi8(',');
+            const __m256i newline = _mm256_set1_epi8('\n');
+            while (end - position >= 32) {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(position));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+                    _mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, newline))));
+                if (mask != 0) {
+                    return position + __builtin_ctz(mask);
+                }
+                position += 32;
+            }
+#endif
+#if defined(__SSE2__)
+            const __m128i comma16 = _mm_set1_epi8(',');
+            const __m128i newline16 = _mm_set1_epi8('\n');
+            while (end - position >= 16) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+                    _mm_cmpeq_epi8(block, comma16), _mm_cmpeq_epi8(block, newline16))));
+                if (mask != 0) {
+                    return position + __builtin_ctz(mask);
+                }
+                position += 16;
+            }
+#endif
+            while (position < end && *position != ',' && *position != '\n') {
+                ++position;
+            }
+            return position;
+        }
+
+        /**
+         * @brief Skips spaces and tabs.
+         *
+         * @param position Start of the range.
+         * @param end End of the range.
+         * @return Pointer to the first character that is neither ' ' nor '\t', or `end`.
+         */
+        static const char* skipBlanks(const char* position, const char* end) {
+            // Padding is usually a few characters, so check the first one before going wide.
+            if (position < end && !isBlank(*position)) {
+                return position;
+            }
+#if defined(__AVX2__)
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            while (end - position >= 32) {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(position));
+                uint32_t blanks = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+                    _mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab))));
+                if (blanks != 0xFFFFFFFFu) {
+                    return position + __builtin_ctz(~blanks);
+                }
+                position += 32;
+            }
+#endif
+#if defined(__SSE2__)
+            const __m128i space16 = _mm_set1_epi8(' ');
+            const __m128i tab16 = _mm_set1_epi8('\t');
+            while (end - position >= 16) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+                uint32_t blanks = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+                    _mm_cmpeq_epi8(block, space16), _mm_cmpeq_epi8(block, tab16))));
+                if (blanks != 0xFFFFu) {
+                    return position + __builtin_ctz(~blanks);
+                }
+                position += 16;
+            }
+#endif
+            while (position < end && isBlank(*position)) {
+                ++position;
+            }
+            return position;
+        }
+
+        /**
+         * @brief Returns the name of the code path selected at compile time.
+         *
+         * @return "AVX2", "SSE2" or "scalar".
+         */
+        static const char* implementation() {
+#if defined(__AVX2__)
+            return "AVX2";
+#elif defined(__SSE2__)
+            return "SSE2";
+#else
+            return "scalar";
+#endif
+        }
+
+    private:
+        static bool isBlank(char c) {
+            return c == ' ' || c == '\t';
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef FILE_LOCK_HPP
+#define FILE_LOCK_HPP
+
+#include <cerrno>
+#include <string>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace am {
+    /**
+     * @class FileLock
+     * @brief Advisory `flock` lock on a lock file, shared between cooperating processes.
+     *
+     * The lock file is created on first use and never removed; only the lock on it matters. A
+     * lock can be held shared by any number of holders or exclusively by one. Locks belong to
+     * the open file, so two `FileLock` objects for the same path conflict with each other even
+     * inside one process. The lock is released when the object is destroyed.
+     */
+    class FileLock {
+    public:
+        /**
+         * @brief The state of a lock.
+         */
+        enum class Mode {
+            /** @brief Not locked. */
+            None,
+
+            /** @brief Held together with other shared holders. */
+            Shared,
+
+            /** @brief Held by this object alone. */
+            Exclusive
+        };
+
+        /**
+         * @brief Constructor for a lock on the given file; the file is opened lazily.
+         *
+         * @param filePath The path of the lock file.
+         */
+        explicit FileLock(const std::string& filePath)
+            : filePath(filePath) {}
+
+        FileLock(const FileLock&) = delete;
+        FileLock& operator=(const FileLock&) = delete;
+
+        /**
+         * @brief Releases the lock and closes the lock file.
+         */
+        ~FileLock() {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        /**
+         * @brief Waits until the lock can be held shared.
+         *
+         * @return True if the lock is held, false if the lock file could not be opened.
+         */
+        bool lockShared() {
+            return acquire(LOCK_SH, Mode::Shared);
+        }
+
+        /**
+         * @brief Waits until the lock can be held exclusively.
+         *
+         * @return True if the lock is held, false if the lock file could not be opened.
+         */
+        bool lockExclusive() {
+            return acquire(LOCK_EX, Mode::Exclusive);
+        }
+
+        /**
+         * @brief Takes the lock exclusively if nobody else holds it, without waiting.
+         *
+         * Converting a shared lock is not atomic: if the conversion fails, the shared lock
+         * held before is released as well and the lock is left unlocked.
+         *
+         * @return True if the lock is now held exclusively, false otherwise.
+         */
+        bool tryLockExclusive() {
+            return acquire(LOCK_EX | LOCK_NB, Mode::Exclusive);
+        }
+
+        /**
+         * @brief Releases the lock.
+         */
+        void unlock() {
+            if (fd >= 0 && mode != Mode::None) {
+                flock(fd, LOCK_UN);
+            }
+            mode = Mode::None;
+        }
+
+        /**
+         * @brief Returns how the lock is currently held.
+         *
+         * @return The lock mode.
+         */
+        Mode getMode() const {
+            return mode;
+        }
+
+    private:
+        /** @brief The path of the lock file. */
+        std::string filePath;
+
+        /** @brief Descriptor of the lock file, or -1 while closed. */
+        int fd = -1;
+
+        /** @brief How the lock is held. */
+        Mode mode = Mode::None;
+
+        bool acquire(int operation, Mode acquired) {
+            if (fd < 0) {
+                fd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if (fd < 0) {
+                    return false;
+                }
+            }
+
+            int result;
+            do {
+                result = flock(fd, operation);
+            } while (result != 0 && errno == EINTR);
+
+            if (result != 0) {
+                // A failed conversion has already dropped the previous lock.
+                mode = Mode::None;
+                return false;
+            }
+            mode = acquired;
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include "Date.hpp"
+#include "Priority.hpp"
+
+namespace am {
+    /**
+     * @class Frame
+     * @brief Reusable text buffer that a whole screen is formatted into before it is printed.
+     *
+     * Numbers, dates and priorities are formatted straight into the buffer without going
+     * through `std::ostream`, and `flush` hands the finished frame to the terminal with a single
+     * `write`. The buffer keeps its capacity between frames, so redrawing the menu does not
+     * allocate once the first frame has been printed.
+     */
+    class Frame {
+    public:
+
+        /**
+         * @brief Appends text.
+         *
+         * @param text The text to append.
+         * @return This frame.
+         */
+        Frame& append(std::string_view text) {
+            buffer.append(text.data(), text.size());
+            return *this;
+        }
+
+        /**
+         * @brief Appends a single character.
+         *
+         * @param character The character to append.
+         * @return This frame.
+         */
+        Frame& append(char character) {
+            buffer.push_back(character);
+            return *this;
+        }
+
+        /**
+         * @brief Appends a number in decimal notation.
+         *
+         * @param number The number to append.
+         * @return This frame.
+         */
+        Frame& append(size_t number) {
+            char digits[20];
+            std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+            buffer.append(digits, static_cast<size_t>(result.ptr - digits));
+            return *this;
+        }
+
+        /**
+         * @brief Appends a date in "DD.MM.YYYY" format.
+         *
+         * @param date The date to append; an invalid date appends nothing.
+         * @return This frame.
+         */
+        Frame& append(Date date) {
+            char text[Date::TEXT_LENGTH];
+            buffer.append(text, date.format(text));
+            return *this;
+        }
+
+        /**
+         * @brief Appends the name of a priority.
+         *
+         * @param priority The priority to append.
+         * @return This frame.
+         */
+        Frame& append(Priority priority) {
+            return append(priorityName(priority));
+        }
+
+        /**
+         * @brief Switches the text color with an ANSI escape sequence.
+         *
+         * @param color The ANSI color code (e.g., 31 for red, 32 for green).
+         * @return This frame.
+         */
+        Frame& setColor(int color) {
+            return append("\033[").append(static_cast<size_t>(color)).append('m');
+        }
+
+        /**
+         * @brief Resets the text color to the default with an ANSI escape sequence.
+         *
+         * @return This frame.
+         */
+        Frame& resetColor() {
+            return append("\033[0m");
+        }
+
+        /**
+         * @brief Returns the formatted text.
+         *
+         * @return A view of the buffer, valid until the frame is changed.
+         */
+        std::string_view view() const {
+            return buffer;
+        }
+
+        /**
+         * @brief Returns the number of formatted bytes.
+         *
+         * @return The buffer size.
+         */
+        size_t size() const {
+            return buffer.size();
+        }
+
+        /**
+         * @brief Discards the formatted text but keeps the capacity.
+         */
+        void clear() {
+            buffer.clear();
+        }
+
+        /**
+         * @brief Writes the frame to a file descriptor and clears it.
+         *
+         * Anything still buffered in `std::cout` is flushed first, so the frame appears after
+         * text printed through the stream.
+         *
+         * @param fd The descriptor to write to, standard output by default.
+         * @return True if the whole frame was written, false otherwise.
+         */
+        bool flush(int fd = STDOUT_FILENO) {
+            std::cout.flush();
+
+            const char* data = buffer.data();
+            size_t remaining = buffer.size();
+            while (remaining > 0) {
+                ssize_t written = ::write(fd, data, remaining);
+                if (written <= 0) {
+                    buffer.clear();
+                    return false;
+                }
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+            buffer.clear();
+            return true;
+        }
+
+    private:
+        /** @brief The formatted text of the current frame. */
+        std::string buffer;
+    };
+}
+
+#endif
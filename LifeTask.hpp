@@ -6,6 +6,7 @@
 #include <string>
 #include <sstream>
 #include "Task.hpp"
+#include "TaskCategory.hpp"
 
 using namespace am;
 
@@ -24,6 +25,12 @@ namespace am {
         /** @brief The file path to save the life tasks. */
         static const std::string FILE_PATH;
 
+        /** @brief The category the life tasks belong to. */
+        static constexpr TaskCategory CATEGORY = TaskCategory::Life;
+
+        /** @brief The number of comma-separated fields of a life task record. */
+        static constexpr size_t FIELD_COUNT = 4;
+
         /** 
          * @brief Default constructor for creating an empty LifeTask.
          * 
@@ -35,15 +42,15 @@ namespace am {
          * @brief Parameterized constructor for creating a LifeTask with given data.
          * 
          * @param description The description of the task.
-         * @param when_to_do The date when the task should be done (DD.MM.YYYY).
-         * @param deadline The deadline for the task (DD.MM.YYYY).
-         * @param priority The priority of the task (low, medium, high).
+         * @param when_to_do The date when the task should be done.
+         * @param deadline The deadline for the task.
+         * @param priority The priority of the task.
          */
         LifeTask(
                 const std::string& description, 
-                const std::string when_to_do, 
-                const std::string& deadline, 
-                const std::string& priority)
+                Date when_to_do, 
+                Date deadline, 
+                Priority priority)
             : Task(description, when_to_do, deadline, priority){}
         
         /** 
@@ -53,12 +60,10 @@ namespace am {
             std::cout << "Life Task:\n";
             std::cout << "  Description: " << description << "\n";
             std::cout << "  When To Do: " << when_to_do << "\n";
-            if (!deadline.empty()) {
+            if (deadline.isValid()) {
                 std::cout << "  Deadline: " << deadline << "\n";
             }
-            if (!priority.empty()) {
-                std::cout << "  Priority: " << priority << "\n";
-            }
+            std::cout << "  Priority: " << priority << "\n";
         }
 
         /** 
@@ -76,16 +81,32 @@ namespace am {
         /** 
          * @brief Loads the task data from a stream (e.g., file or string).
          * 
+         * The next line of the stream is split by `RecordReader` and passed to `loadFromFields`.
+         * 
          * @param stream The input stream from which to read the task data.
          * @return True if the task data is successfully loaded, false otherwise.
          */
         bool loadFromStream(std::istringstream& stream) override {
-            std::getline(stream, description, ',');
-            std::getline(stream, when_to_do, ',');
-            std::getline(stream, deadline, ',');
-            std::getline(stream, priority, ',');
-            
-            return !(description.empty() || when_to_do.empty() || deadline.empty() || priority.empty());
+            std::string line;
+            std::getline(stream, line);
+
+            RecordFields fields;
+            RecordReader::splitLine(line, fields);
+            return loadFromFields(fields);
+        }
+
+        /** 
+         * @brief Loads the task data from tokenized fields.
+         * 
+         * @param fields The fields of one record (description, dates, priority).
+         * @return True if the task data is successfully loaded, false otherwise.
+         */
+        bool loadFromFields(const RecordFields& fields) override {
+            description.assign(fields[0]);
+            bool validDates = loadDatesFromFields(fields, 1);
+            bool validPriority = parsePriority(fields[3], priority);
+
+            return validDates && validPriority && !description.empty();
         }
 
         /** 
@@ -94,7 +115,16 @@ namespace am {
          * @return A string representation of the task for file storage.
          */
         std::string toFileString() const override {
-            return  description + ", " + when_to_do + ", " + deadline + ", " + priority + "\n";
+            return  description + ", " + when_to_do.toString() + ", " + deadline.toString() + ", " + std::string(priorityName(priority)) + "\n";
+        }
+
+        /** 
+         * @brief Formats the task details for the console into a frame.
+         * 
+         * @param frame The frame the task details are appended to.
+         */
+        void render(Frame& frame) const override {
+            renderCommon(frame);
         }
 
         /** 
@@ -105,15 +135,12 @@ namespace am {
          * @return The output stream with the task details.
          */
         friend std::ostream& operator<<(std::ostream& os, const LifeTask& task) {
-            os << "  Description: " << task.getDescription() << "\n";
-            os << "  Deadline: " << task.getDeadline() << "\n";
-            os << "  Priority: " << task.getPriority() << "\n";
-            return os;
+            Frame frame;
+            task.render(frame);
+            std::string_view text = frame.view();
+            return os.write(text.data(), static_cast<std::streamsize>(text.size()));
         }
     };
-
-    /** @brief The file path for storing life tasks. */
-    const std::string LifeTask::FILE_PATH = "life.txt";
 }
 
 #endif
\ No newline at end of file
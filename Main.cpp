@@ -1,25 +1,207 @@
 /**
  * @file Main.cpp
  * @brief Main entry point for the task management application.
- * 
+ *
  * This file contains the `main` function, which is the entry point of the task management application.
- * It initializes the `TaskService` class and starts the application by calling its `runApplication` method.
+ * Without arguments it initializes the `TaskService` class and starts the application by calling its
+ * `runApplication` method. With the `import` command it bulk-loads tasks without any prompts, and
+ * the `snapshot` command converts between a category file and its binary snapshot.
  */
 
 #include <iostream>
-#include "TaskService.hpp"
+#include <iterator>
 #include <string>
+#include "MappedFile.hpp"
+#include "TaskImporter.hpp"
+#include "TaskService.hpp"
+#include "TaskSnapshot.hpp"
 using namespace am;
 
+/**
+ * @brief Prints the command line usage.
+ */
+void printUsage() {
+    std::cerr << "Usage:\n"
+              << "  TaskManager                                    Start the interactive application\n"
+              << "  TaskManager import --type <study|life|work> [file|-]\n"
+              << "                                                 Import tasks from a file or stdin\n"
+              << "  TaskManager snapshot <import|export> --type <study|life|work> [snapshot]\n"
+              << "                                                 Build a snapshot from the category file,\n"
+              << "                                                 or rewrite the category file from it\n";
+}
+
+/**
+ * @brief Imports tasks of one category from a text buffer and prints a summary.
+ *
+ * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+ * @param text The rows to import.
+ * @return int Exit status: 0 if every row was imported and written or skipped as a duplicate,
+ *         1 otherwise.
+ */
+template <typename T>
+int importRows(std::string_view text) {
+    TaskRepository repository;
+    TaskImporter importer(repository);
+    ImportReport report = importer.importTasks<T>(text);
+
+    std::cout << "Imported " << report.imported << " of " << report.rows << " rows into " << T::FILE_PATH
+              << " (" << report.duplicates << " duplicates, " << report.invalid << " invalid) in "
+              << report.seconds << " s, " << static_cast<size_t>(report.rowsPerSecond()) << " rows/s.\n";
+    if (report.failed > 0) {
+        std::cerr << "Error: " << report.failed << " rows could not be written to " << T::FILE_PATH << ".\n";
+    }
+    if (!report.written) {
+        std::cerr << "Error: The imported tasks could not be synced to " << T::FILE_PATH
+                  << "; they may not have been saved.\n";
+    }
+    return report.succeeded() ? 0 : 1;
+}
+
+/**
+ * @brief Runs the `import` command.
+ *
+ * Reads rows in the format of the category files from the given file, or from standard input
+ * if no file or "-" is given, and appends them to the category chosen with `--type`.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments; `argv[1]` is "import".
+ * @return int Exit status of the command.
+ */
+int runImport(int argc, char* argv[]) {
+    std::string type;
+    std::string source = "-";
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--type") {
+            if (i + 1 >= argc) {
+                printUsage();
+                return 2;
+            }
+            type = argv[++i];
+        } else {
+            source = argument;
+        }
+    }
+
+    std::string input;
+    MappedFile file;
+    std::string_view text;
+    if (source == "-") {
+        input.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        text = input;
+    } else if (file.open(source)) {
+        text = file.data();
+    } else {
+        std::cerr << "Error: Could not open file: " << source << "\n";
+        return 1;
+    }
+
+    if (type == "study") {
+        return importRows<StudyTask>(text);
+    } else if (type == "life") {
+        return importRows<LifeTask>(text);
+    } else if (type == "work") {
+        return importRows<WorkTask>(text);
+    }
+
+    printUsage();
+    return 2;
+}
+
+/**
+ * @brief Converts between the category file of one type and its binary snapshot.
+ *
+ * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+ * @param direction "import" reads the category file into the snapshot, "export" rewrites the
+ *        category file from the snapshot once no other session is open.
+ * @param snapshotPath The path of the snapshot, or empty for the default next to the file.
+ * @return int Exit status: 0 on success, 1 on failure, 2 for an unknown direction.
+ */
+template <typename T>
+int convertSnapshot(const std::string& direction, std::string snapshotPath) {
+    if (snapshotPath.empty()) {
+        snapshotPath = TaskSnapshot::pathFor(T::FILE_PATH);
+    }
+
+    if (direction == "import") {
+        if (!TaskSnapshot::importText<T>(T::FILE_PATH, snapshotPath)) {
+            return 1;
+        }
+        std::cout << "Wrote " << snapshotPath << " from " << T::FILE_PATH << ".\n";
+        return 0;
+    } else if (direction == "export") {
+        TaskRepository repository;
+        if (!repository.restoreSnapshot<T>(snapshotPath)) {
+            return 1;
+        }
+        std::cout << "Wrote " << T::FILE_PATH << " from " << snapshotPath << ".\n";
+        return 0;
+    }
+
+    printUsage();
+    return 2;
+}
+
+/**
+ * @brief Runs the `snapshot` command.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments; `argv[1]` is "snapshot".
+ * @return int Exit status of the command.
+ */
+int runSnapshot(int argc, char* argv[]) {
+    std::string direction = argc > 2 ? argv[2] : "";
+    std::string type;
+    std::string snapshotPath;
+    for (int i = 3; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--type") {
+            if (i + 1 >= argc) {
+                printUsage();
+                return 2;
+            }
+            type = argv[++i];
+        } else {
+            snapshotPath = argument;
+        }
+    }
+
+    if (type == "study") {
+        return convertSnapshot<StudyTask>(direction, snapshotPath);
+    } else if (type == "life") {
+        return convertSnapshot<LifeTask>(direction, snapshotPath);
+    } else if (type == "work") {
+        return convertSnapshot<WorkTask>(direction, snapshotPath);
+    }
+
+    printUsage();
+    return 2;
+}
+
 /**
  * @brief The main function for running the task management application.
- * 
- * This function creates an instance of `TaskService` and invokes the `runApplication` method to start
- * the task management system. The program will continue running until the user decides to exit.
- * 
+ *
+ * Without arguments this function creates an instance of `TaskService` and invokes the
+ * `runApplication` method to start the task management system. The program will continue running
+ * until the user decides to exit. `TaskManager import ...` runs a non-interactive bulk import and
+ * `TaskManager snapshot ...` a snapshot conversion instead.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv The command line arguments.
  * @return int Exit status of the program. Returns 0 if the program executes successfully.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        if (std::string(argv[1]) == "import") {
+            return runImport(argc, argv);
+        }
+        if (std::string(argv[1]) == "snapshot") {
+            return runSnapshot(argc, argv);
+        }
+        printUsage();
+        return 2;
+    }
+
     // Create an instance of TaskService
     TaskService taskService;
 
@@ -0,0 +1,158 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace am {
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The file contents are exposed as a `std::string_view` that stays valid for the lifetime
+     * of the object, so records can be tokenized in place without copying them into
+     * `std::string` buffers.
+     */
+    class MappedFile {
+    public:
+
+        /**
+         * @brief Default constructor for creating an empty mapping.
+         */
+        MappedFile() = default;
+
+        /**
+         * @brief Constructor that maps the given file.
+         *
+         * @param filePath The path of the file to map.
+         */
+        explicit MappedFile(const std::string& filePath) {
+            open(filePath);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : address(other.address), length(other.length), opened(other.opened) {
+            other.address = nullptr;
+            other.length = 0;
+            other.opened = false;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                address = other.address;
+                length = other.length;
+                opened = other.opened;
+                other.address = nullptr;
+                other.length = 0;
+                other.opened = false;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~MappedFile() {
+            close();
+        }
+
+        /**
+         * @brief Maps a file into memory, replacing any previous mapping.
+         *
+         * An empty file is opened successfully and yields an empty view.
+         *
+         * @param filePath The path of the file to map.
+         * @return True if the file could be opened and mapped, false otherwise.
+         */
+        bool open(const std::string& filePath) {
+            close();
+
+            int fd = ::open(filePath.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                return false;
+            }
+
+            length = static_cast<size_t>(info.st_size);
+            if (length > 0) {
+                void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    ::close(fd);
+                    length = 0;
+                    return false;
+                }
+                address = mapped;
+                madvise(address, length, MADV_SEQUENTIAL);
+            }
+
+            ::close(fd);
+            opened = true;
+            return true;
+        }
+
+        /**
+         * @brief Releases the mapping.
+         */
+        void close() {
+            if (address != nullptr) {
+                munmap(address, length);
+            }
+            address = nullptr;
+            length = 0;
+            opened = false;
+        }
+
+        /**
+         * @brief Checks whether a file is currently mapped.
+         *
+         * @return True if `open()` succeeded, false otherwise.
+         */
+        bool isOpen() const {
+            return opened;
+        }
+
+        /**
+         * @brief Returns the mapped file contents.
+         *
+         * @return A view of the whole file.
+         */
+        std::string_view data() const {
+            return std::string_view(static_cast<const char*>(address), length);
+        }
+
+        /**
+         * @brief Returns the size of the mapped file.
+         *
+         * @return The file size in bytes.
+         */
+        size_t size() const {
+            return length;
+        }
+
+    private:
+        /** @brief Start of the mapping, or null for an empty or closed file. */
+        void* address = nullptr;
+
+        /** @brief Length of the mapping in bytes. */
+        size_t length = 0;
+
+        /** @brief Whether a file is currently open. */
+        bool opened = false;
+    };
+}
+
+#endif
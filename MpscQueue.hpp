@@ -0,0 +1,113 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace am {
+    /**
+     * @class MpscQueue
+     * @brief Unbounded lock-free queue with any number of producers and a single consumer.
+     *
+     * Producers link a new node with one atomic exchange and never wait for each other or for
+     * the consumer. Only one thread may call `pop` and `empty`. A value whose producer has
+     * exchanged the head but not yet linked the node is not visible to the consumer for that
+     * short moment; `pop` then reports an empty queue and the value is returned by a later call.
+     *
+     * @tparam T The type of the queued values; it must be movable and default-constructible.
+     */
+    template <typename T>
+    class MpscQueue {
+    public:
+
+        /**
+         * @brief Constructor for an empty queue.
+         */
+        MpscQueue()
+            : head(&stub), tail(&stub) {}
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /**
+         * @brief Destroys the values still queued.
+         */
+        ~MpscQueue() {
+            T value;
+            while (pop(value)) {
+            }
+            if (tail != &stub) {
+                delete tail;
+            }
+        }
+
+        /**
+         * @brief Appends a value; may be called from any thread.
+         *
+         * @param value The value to append.
+         */
+        void push(T value) {
+            Node* node = new Node(std::move(value));
+            Node* previous = head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        /**
+         * @brief Removes the oldest value; only the consumer thread may call this.
+         *
+         * @param value Receives the value.
+         * @return True if a value was removed, false if the queue is empty.
+         */
+        bool pop(T& value) {
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+            value = std::move(next->value);
+            if (tail != &stub) {
+                delete tail;
+            }
+            // The node that held the value becomes the new, empty front.
+            tail = next;
+            return true;
+        }
+
+        /**
+         * @brief Checks whether a value can be popped; only the consumer thread may call this.
+         *
+         * @return True if no value is visible to the consumer.
+         */
+        bool empty() const {
+            return tail->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        /**
+         * @struct Node
+         * @brief One queued value.
+         */
+        struct Node {
+            Node() = default;
+
+            explicit Node(T value)
+                : value(std::move(value)) {}
+
+            /** @brief The queued value; moved out when the node becomes the front. */
+            T value;
+
+            /** @brief The next node, linked by the producer that appended it. */
+            std::atomic<Node*> next{nullptr};
+        };
+
+        /** @brief Empty node the queue starts with. */
+        Node stub;
+
+        /** @brief The most recently pushed node, shared by all producers. */
+        std::atomic<Node*> head;
+
+        /** @brief The consumed front node; its successor holds the oldest value. */
+        Node* tail;
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef PRIORITY_HPP
+#define PRIORITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace am {
+    /**
+     * @brief The priority of a task.
+     *
+     * The values are ordered by importance, so priorities can be compared and sorted as
+     * integers, and a priority fits in the one-byte column of a `TaskTable`.
+     */
+    enum class Priority : uint8_t {
+        Low = 0,
+        Medium = 1,
+        High = 2
+    };
+
+    /** @brief Number of priorities. */
+    constexpr size_t PRIORITY_COUNT = 3;
+
+    /** @brief Text of every priority as stored in the task files, indexed by value. */
+    constexpr std::string_view PRIORITY_NAMES[PRIORITY_COUNT] = {"low", "medium", "high"};
+
+    /**
+     * @brief Returns the text of a priority as stored in the task files.
+     *
+     * @param priority The priority.
+     * @return "low", "medium" or "high".
+     */
+    constexpr std::string_view priorityName(Priority priority) {
+        return PRIORITY_NAMES[static_cast<size_t>(priority)];
+    }
+
+    /**
+     * @brief Parses the text of a priority.
+     *
+     * Surrounding blanks are ignored and letters may be in any case, so "High" and " low"
+     * are accepted.
+     *
+     * @param text The text to parse.
+     * @param priority Receives the priority on success.
+     * @return True if `text` names a priority, false otherwise.
+     */
+    constexpr bool parsePriority(std::string_view text, Priority& priority) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+            text.remove_suffix(1);
+        }
+
+        for (size_t value = 0; value < PRIORITY_COUNT; ++value) {
+            std::string_view name = PRIORITY_NAMES[value];
+            if (name.size() != text.size()) {
+                continue;
+            }
+
+            size_t i = 0;
+            // Setting bit 5 lowercases ASCII letters; the names contain nothing else.
+            while (i < name.size() && (text[i] | 0x20) == name[i]) {
+                ++i;
+            }
+            if (i == name.size()) {
+                priority = static_cast<Priority>(value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns a bit mask with the bit of one priority set.
+     *
+     * Masks of several priorities can be combined with `|` and tested against a priority
+     * column without branching: `(mask >> static_cast<unsigned>(priority)) & 1`.
+     *
+     * @param priority The priority.
+     * @return The mask.
+     */
+    constexpr uint8_t priorityMask(Priority priority) {
+        return static_cast<uint8_t>(1u << static_cast<unsigned>(priority));
+    }
+
+    inline std::ostream& operator<<(std::ostream& os, Priority priority) {
+        return os << priorityName(priority);
+    }
+
+    static_assert(priorityName(Priority::High) == "high", "priority table out of order");
+}
+
+#endif
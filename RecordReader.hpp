@@ -0,0 +1,136 @@
+#ifndef RECORD_READER_HPP
+#define RECORD_READER_HPP
+
+#include <cstddef>
+#include <string_view>
+#include "DelimiterScanner.hpp"
+
+namespace am {
+    /**
+     * @struct RecordFields
+     * @brief The comma-separated fields of one task record, as views into the source text.
+     *
+     * Leading whitespace of every field is already skipped. The views point into the buffer
+     * that was tokenized and are only valid as long as that buffer is.
+     */
+    struct RecordFields {
+        /** @brief Maximum number of fields kept per record; further fields are ignored. */
+        static constexpr size_t MAX_FIELDS = 8;
+
+        /** @brief The field values. */
+        std::string_view values[MAX_FIELDS];
+
+        /** @brief The number of fields found in the record. */
+        size_t count = 0;
+
+        /**
+         * @brief Returns a field, or an empty view if the record has fewer fields.
+         *
+         * @param index The zero-based field index.
+         * @return The field value.
+         */
+        std::string_view operator[](size_t index) const {
+            return index < count ? values[index] : std::string_view();
+        }
+    };
+
+    /**
+     * @class RecordReader
+     * @brief Splits task file contents into lines and fields without copying.
+     *
+     * The reader walks a text buffer (typically a `MappedFile`) line by line and tokenizes each
+     * line in place into `RecordFields`. Delimiters and field padding are located with the
+     * vectorized `DelimiterScanner`, in a single pass over the text. No memory is allocated
+     * while reading.
+     */
+    class RecordReader {
+    public:
+
+        /**
+         * @brief Constructor for reading records from a text buffer.
+         *
+         * @param text The text to read; it must outlive the reader and the returned fields.
+         */
+        explicit RecordReader(std::string_view text)
+            : current(text.data()), end(text.data() + text.size()) {}
+
+        /**
+         * @brief Reads the next line and splits it into fields.
+         *
+         * Blank lines are returned as records with a single empty field.
+         *
+         * @param fields Receives the fields of the line.
+         * @return True if a line was read, false at the end of the text.
+         */
+        bool next(RecordFields& fields) {
+            if (current >= end) {
+                return false;
+            }
+
+            lineBegin = current;
+            lineEnd = tokenize(current, end, fields);
+            current = lineEnd < end ? lineEnd + 1 : end;
+            return true;
+        }
+
+        /**
+         * @brief Returns the line last read by `next()`, exactly as it appears in the text.
+         *
+         * @return The line without its newline character.
+         */
+        std::string_view line() const {
+            return std::string_view(lineBegin, static_cast<size_t>(lineEnd - lineBegin));
+        }
+
+        /**
+         * @brief Splits a single line into comma-separated fields.
+         *
+         * Leading spaces and tabs of every field are skipped and a trailing carriage return is
+         * dropped. This is the same tokenization `next()` applies to every line of a file.
+         *
+         * @param line The line without its newline character.
+         * @param fields Receives the fields of the line.
+         */
+        static void splitLine(std::string_view line, RecordFields& fields) {
+            tokenize(line.data(), line.data() + line.size(), fields);
+        }
+
+    private:
+        /** @brief Start of the next unread line. */
+        const char* current;
+
+        /** @brief End of the text. */
+        const char* end;
+
+        /** @brief Start of the line last read. */
+        const char* lineBegin = nullptr;
+
+        /** @brief End of the line last read. */
+        const char* lineEnd = nullptr;
+
+        static const char* tokenize(const char* position, const char* end, RecordFields& fields) {
+            fields.count = 0;
+
+            while (true) {
+                position = DelimiterScanner::skipBlanks(position, end);
+                const char* delimiter = DelimiterScanner::findDelimiter(position, end);
+
+                bool lastField = delimiter == end || *delimiter == '\n';
+                if (fields.count < RecordFields::MAX_FIELDS) {
+                    std::string_view field(position, delimiter - position);
+                    if (lastField && !field.empty() && field.back() == '\r') {
+                        field.remove_suffix(1);
+                    }
+                    fields.values[fields.count++] = field;
+                }
+
+                if (lastField) {
+                    return delimiter;
+                }
+                position = delimiter + 1;
+            }
+        }
+    };
+}
+
+#endif
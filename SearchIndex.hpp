@@ -0,0 +1,285 @@
+#ifndef SEARCH_INDEX_HPP
+#define SEARCH_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "TaskCategory.hpp"
+
+namespace am {
+    /**
+     * @class SearchIndex
+     * @brief Inverted index from the words of the tasks of one category to their ids.
+     *
+     * A word is a run of ASCII letters and digits (bytes of UTF-8 sequences count as letters)
+     * and is stored in lower case, so queries are case-insensitive. The words are kept in a
+     * balanced tree, which makes looking up a word O(log n) and turns a prefix into a contiguous
+     * range of words. Each word maps to the sorted ids of the tasks containing it; since new
+     * tasks get increasing ids, adding a task only appends to these lists. A removed task is only
+     * marked as such and skipped by queries, so marking a task as done never has to walk the
+     * long lists of common words; editing a task touches just the words that changed.
+     *
+     * A query is a list of words that must all occur in a task. A word ending in `*` matches
+     * every word starting with it. The list of the rarest word is intersected with the others,
+     * so the cost depends on the matches, not on the number of tasks.
+     */
+    class SearchIndex {
+    public:
+        /**
+         * @brief Adds the words of one field of a task.
+         *
+         * @param id The id of the task.
+         * @param text The text of the field.
+         */
+        void add(TaskId id, std::string_view text) {
+            forEachWord(text, [this, id](const std::string& word, bool) {
+                addWord(id, word);
+            });
+        }
+
+        /**
+         * @brief Changes the words of a task whose text was edited.
+         *
+         * @param id The id of the task.
+         * @param before The words of the task before the edit, as returned by `wordsOf`.
+         * @param after The words of the task after the edit, as returned by `wordsOf`.
+         */
+        void replace(TaskId id, const std::vector<std::string>& before, const std::vector<std::string>& after) {
+            std::vector<std::string> changed;
+            std::set_difference(before.begin(), before.end(), after.begin(), after.end(),
+                std::back_inserter(changed));
+            for (const std::string& word : changed) {
+                removeWord(id, word);
+            }
+            changed.clear();
+            std::set_difference(after.begin(), after.end(), before.begin(), before.end(),
+                std::back_inserter(changed));
+            for (const std::string& word : changed) {
+                addWord(id, word);
+            }
+        }
+
+        /**
+         * @brief Removes a task from the results of all later queries.
+         *
+         * @param id The id of the task; ids are not reused until `clear()`.
+         */
+        void remove(TaskId id) {
+            if (removed.size() <= id) {
+                removed.resize(static_cast<size_t>(id) + 1, false);
+            }
+            removed[id] = true;
+        }
+
+        /**
+         * @brief Returns the distinct words of the given texts.
+         *
+         * @param texts The fields of one task.
+         * @return The words in lower case, sorted and without duplicates.
+         */
+        static std::vector<std::string> wordsOf(std::initializer_list<std::string_view> texts) {
+            std::vector<std::string> words;
+            for (std::string_view text : texts) {
+                forEachWord(text, [&words](const std::string& word, bool) {
+                    words.push_back(word);
+                });
+            }
+            std::sort(words.begin(), words.end());
+            words.erase(std::unique(words.begin(), words.end()), words.end());
+            return words;
+        }
+
+        /**
+         * @brief Finds the tasks containing every word of a query.
+         *
+         * @param query Words separated by spaces or punctuation; `*` after a word makes it a prefix.
+         * @return The ids of the matching tasks in ascending order, empty for an empty query.
+         */
+        std::vector<TaskId> find(std::string_view query) const {
+            std::vector<Term> terms;
+            forEachWord(query, [&terms](const std::string& word, bool prefix) {
+                terms.push_back(Term{word, prefix});
+            });
+            if (terms.empty()) {
+                return {};
+            }
+
+            // Each term is one list, or several for a prefix; the smallest total goes first.
+            std::vector<std::vector<const std::vector<TaskId>*>> lists;
+            std::vector<size_t> sizes;
+            for (const Term& term : terms) {
+                lists.push_back(matches(term));
+                size_t size = 0;
+                for (const std::vector<TaskId>* ids : lists.back()) {
+                    size += ids->size();
+                }
+                if (size == 0) {
+                    return {};
+                }
+                sizes.push_back(size);
+            }
+            std::vector<size_t> order(terms.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&sizes](size_t lhs, size_t rhs) {
+                return sizes[lhs] < sizes[rhs];
+            });
+
+            std::vector<TaskId> result = merge(lists[order.front()]);
+            result.erase(std::remove_if(result.begin(), result.end(), [this](TaskId id) {
+                return id < removed.size() && removed[id];
+            }), result.end());
+            for (size_t i = 1; i < order.size() && !result.empty(); ++i) {
+                std::vector<const std::vector<TaskId>*> other = lists[order[i]];
+                // A prefix matching many words is cheaper to search once merged.
+                std::vector<TaskId> merged;
+                if (other.size() > MAX_PROBED_LISTS) {
+                    merged = merge(other);
+                    other.assign(1, &merged);
+                }
+                result.erase(std::remove_if(result.begin(), result.end(), [&other](TaskId id) {
+                    return !containsAny(other, id);
+                }), result.end());
+            }
+            return result;
+        }
+
+        /**
+         * @brief Removes every word.
+         */
+        void clear() {
+            postings.clear();
+            removed.clear();
+        }
+
+        /**
+         * @brief Returns the number of distinct words.
+         *
+         * @return The number of words in the index.
+         */
+        size_t wordCount() const {
+            return postings.size();
+        }
+
+    private:
+        /**
+         * @struct Term
+         * @brief One word of a query.
+         */
+        struct Term {
+            /** @brief The word in lower case. */
+            std::string word;
+
+            /** @brief Whether the word was followed by `*`. */
+            bool prefix;
+        };
+
+        /** @brief Largest number of lists a prefix term is searched in without merging them. */
+        static constexpr size_t MAX_PROBED_LISTS = 8;
+
+        /** @brief The sorted ids of the tasks containing each word. */
+        std::map<std::string, std::vector<TaskId>, std::less<>> postings;
+
+        /** @brief Whether each task has been removed; its id may still be in `postings`. */
+        std::vector<bool> removed;
+
+        void addWord(TaskId id, const std::string& word) {
+            std::vector<TaskId>& ids = postings[word];
+            if (ids.empty() || ids.back() < id) {
+                ids.push_back(id);
+                return;
+            }
+            auto position = std::lower_bound(ids.begin(), ids.end(), id);
+            if (*position != id) {
+                ids.insert(position, id);
+            }
+        }
+
+        void removeWord(TaskId id, const std::string& word) {
+            auto entry = postings.find(word);
+            if (entry == postings.end()) {
+                return;
+            }
+            std::vector<TaskId>& ids = entry->second;
+            auto position = std::lower_bound(ids.begin(), ids.end(), id);
+            if (position != ids.end() && *position == id) {
+                ids.erase(position);
+            }
+            if (ids.empty()) {
+                postings.erase(entry);
+            }
+        }
+
+        static bool isWordByte(char c) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            return (byte >= '0' && byte <= '9') || (byte >= 'a' && byte <= 'z')
+                || (byte >= 'A' && byte <= 'Z') || byte >= 0x80;
+        }
+
+        template <typename Callback>
+        static void forEachWord(std::string_view text, Callback&& callback) {
+            std::string word;
+            size_t i = 0;
+            while (i < text.size()) {
+                if (!isWordByte(text[i])) {
+                    ++i;
+                    continue;
+                }
+                word.clear();
+                while (i < text.size() && isWordByte(text[i])) {
+                    char c = text[i++];
+                    word.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+                }
+                callback(word, i < text.size() && text[i] == '*');
+            }
+        }
+
+        std::vector<const std::vector<TaskId>*> matches(const Term& term) const {
+            std::vector<const std::vector<TaskId>*> lists;
+            if (!term.prefix) {
+                auto entry = postings.find(term.word);
+                if (entry != postings.end()) {
+                    lists.push_back(&entry->second);
+                }
+                return lists;
+            }
+            for (auto entry = postings.lower_bound(term.word);
+                 entry != postings.end() && entry->first.compare(0, term.word.size(), term.word) == 0;
+                 ++entry) {
+                lists.push_back(&entry->second);
+            }
+            return lists;
+        }
+
+        static std::vector<TaskId> merge(const std::vector<const std::vector<TaskId>*>& lists) {
+            if (lists.size() == 1) {
+                return *lists.front();
+            }
+            std::vector<TaskId> result;
+            for (const std::vector<TaskId>* ids : lists) {
+                result.insert(result.end(), ids->begin(), ids->end());
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+
+        static bool containsAny(const std::vector<const std::vector<TaskId>*>& lists, TaskId id) {
+            for (const std::vector<TaskId>* ids : lists) {
+                if (std::binary_search(ids->begin(), ids->end(), id)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef STRING_ARENA_HPP
+#define STRING_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace am {
+    /**
+     * @class StringArena
+     * @brief Bump allocator that owns the text of many strings in a few large blocks.
+     *
+     * Strings are copied back to back into blocks that are never moved or freed individually,
+     * so the returned views stay valid until the arena is cleared or destroyed, and storing a
+     * string costs a `memcpy` instead of a heap allocation. Clearing the arena releases all
+     * text at once.
+     */
+    class StringArena {
+    public:
+        /** @brief Size of the first block; later blocks double up to `MAX_BLOCK_SIZE`. */
+        static constexpr size_t MIN_BLOCK_SIZE = 4 * 1024;
+
+        /** @brief Largest size a regular block grows to. */
+        static constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+        StringArena() = default;
+        StringArena(const StringArena&) = delete;
+        StringArena& operator=(const StringArena&) = delete;
+        StringArena(StringArena&&) noexcept = default;
+        StringArena& operator=(StringArena&&) noexcept = default;
+
+        /**
+         * @brief Copies a string into the arena.
+         *
+         * @param value The string to copy.
+         * @return A view of the copy, valid until the arena is cleared or destroyed.
+         */
+        std::string_view store(std::string_view value) {
+            if (value.empty()) {
+                return std::string_view();
+            }
+            if (value.size() > remaining) {
+                grow(value.size());
+            }
+
+            char* copy = cursor;
+            std::memcpy(copy, value.data(), value.size());
+            cursor += value.size();
+            remaining -= value.size();
+            used += value.size();
+            return std::string_view(copy, value.size());
+        }
+
+        /**
+         * @brief Takes over all blocks of another arena.
+         *
+         * Views into the other arena stay valid and are owned by this arena afterwards; the
+         * other arena is left empty.
+         *
+         * @param other The arena to take the blocks from.
+         */
+        void adopt(StringArena& other) {
+            for (auto& block : other.blocks) {
+                // Keep the current block last so its free space is still used.
+                blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), std::move(block));
+            }
+            used += other.used;
+            allocated += other.allocated;
+            other.blocks.clear();
+            other.cursor = nullptr;
+            other.remaining = 0;
+            other.used = 0;
+            other.allocated = 0;
+            other.nextBlockSize = MIN_BLOCK_SIZE;
+        }
+
+        /**
+         * @brief Releases all text stored in the arena.
+         */
+        void clear() {
+            blocks.clear();
+            cursor = nullptr;
+            remaining = 0;
+            used = 0;
+            allocated = 0;
+            nextBlockSize = MIN_BLOCK_SIZE;
+        }
+
+        /**
+         * @brief Returns the number of bytes of text stored in the arena.
+         *
+         * @return The stored bytes.
+         */
+        size_t bytesUsed() const {
+            return used;
+        }
+
+        /**
+         * @brief Returns the number of bytes allocated for blocks.
+         *
+         * @return The allocated bytes.
+         */
+        size_t bytesAllocated() const {
+            return allocated;
+        }
+
+    private:
+        /** @brief The blocks holding the text; the last one is being filled. */
+        std::vector<std::unique_ptr<char[]>> blocks;
+
+        /** @brief Next free byte of the last block. */
+        char* cursor = nullptr;
+
+        /** @brief Free bytes left in the last block. */
+        size_t remaining = 0;
+
+        /** @brief Bytes of text stored so far. */
+        size_t used = 0;
+
+        /** @brief Bytes allocated for blocks so far. */
+        size_t allocated = 0;
+
+        /** @brief Size of the next regular block. */
+        size_t nextBlockSize = MIN_BLOCK_SIZE;
+
+        void grow(size_t needed) {
+            size_t size = std::max(nextBlockSize, needed);
+            blocks.emplace_back(new char[size]);
+            cursor = blocks.back().get();
+            remaining = size;
+            allocated += size;
+            nextBlockSize = std::min(nextBlockSize * 2, MAX_BLOCK_SIZE);
+        }
+    };
+
+    /**
+     * @class StringInterner
+     * @brief Keeps one copy of every distinct string and refers to it by a small number.
+     *
+     * Fields with few distinct values, such as subjects, assignees and priorities, repeat on
+     * thousands of rows. Interning stores each distinct value once in a `StringArena` and
+     * hands out a 32-bit symbol for it, so a row stores four bytes instead of a string.
+     */
+    class StringInterner {
+    public:
+        /** @brief Number identifying an interned string. */
+        using Symbol = uint32_t;
+
+        /**
+         * @brief Returns the symbol of a string, adding the string if it is new.
+         *
+         * @param value The string to intern.
+         * @param arena The arena new strings are copied into. It must outlive the interner's
+         *        use of the string and should be the same arena on every call.
+         * @return The symbol of the string.
+         */
+        Symbol intern(std::string_view value, StringArena& arena) {
+            auto found = symbols.find(value);
+            if (found != symbols.end()) {
+                return found->second;
+            }
+
+            std::string_view stored = arena.store(value);
+            Symbol symbol = static_cast<Symbol>(values.size());
+            values.push_back(stored);
+            symbols.emplace(stored, symbol);
+            return symbol;
+        }
+
+        /**
+         * @brief Looks up a string without adding it.
+         *
+         * @param value The string to look for.
+         * @param symbol Receives the symbol of the string on success.
+         * @return True if the string has been interned, false otherwise.
+         */
+        bool find(std::string_view value, Symbol& symbol) const {
+            auto found = symbols.find(value);
+            if (found == symbols.end()) {
+                return false;
+            }
+            symbol = found->second;
+            return true;
+        }
+
+        /**
+         * @brief Returns the string of a symbol.
+         *
+         * @param symbol A symbol returned by `intern`.
+         * @return The interned string.
+         */
+        std::string_view view(Symbol symbol) const {
+            return values[symbol];
+        }
+
+        /**
+         * @brief Returns the number of distinct strings.
+         *
+         * @return The number of symbols handed out.
+         */
+        size_t size() const {
+            return values.size();
+        }
+
+        /**
+         * @brief Forgets all strings. The text itself is owned by the arena.
+         */
+        void clear() {
+            symbols.clear();
+            values.clear();
+        }
+
+    private:
+        /** @brief Symbol of every interned string. */
+        std::unordered_map<std::string_view, Symbol> symbols;
+
+        /** @brief Interned strings, indexed by symbol. */
+        std::vector<std::string_view> values;
+    };
+}
+
+#endif
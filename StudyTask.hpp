@@ -6,6 +6,7 @@
 #include <string>
 #include <sstream>
 #include "Task.hpp"
+#include "TaskCategory.hpp"
 using namespace am;
 
 namespace am {
@@ -26,6 +27,12 @@ namespace am {
         /** @brief The file path to save the study tasks. */
         static const std::string FILE_PATH;
 
+        /** @brief The category the study tasks belong to. */
+        static constexpr TaskCategory CATEGORY = TaskCategory::Study;
+
+        /** @brief The number of comma-separated fields of a study task record. */
+        static constexpr size_t FIELD_COUNT = 5;
+
         /** 
          * @brief Default constructor for creating an empty StudyTask.
          * 
@@ -38,16 +45,16 @@ namespace am {
          * @brief Parameterized constructor for creating a StudyTask with given data.
          * 
          * @param description The description of the task.
-         * @param when_to_do The date when the task should be done (DD.MM.YYYY).
-         * @param deadline The deadline for the task (DD.MM.YYYY).
-         * @param priority The priority of the task (low, medium, high).
+         * @param when_to_do The date when the task should be done.
+         * @param deadline The deadline for the task.
+         * @param priority The priority of the task.
          * @param subject The subject of the study task.
          */
         StudyTask(
             const std::string& description,
-            const std::string& when_to_do,
-            const std::string& deadline,
-            const std::string& priority,
+            Date when_to_do,
+            Date deadline,
+            Priority priority,
             const std::string& subject)
             : Task(description, when_to_do, deadline, priority), subject(subject) {}
         
@@ -78,17 +85,33 @@ namespace am {
         /** 
          * @brief Loads the task data from a stream (e.g., file or string).
          * 
+         * The next line of the stream is split by `RecordReader` and passed to `loadFromFields`.
+         * 
          * @param stream The input stream from which to read the task data.
          * @return True if the task data is successfully loaded, false otherwise.
          */
         bool loadFromStream(std::istringstream& stream) override {
-            std::getline(stream, subject, ',');
-            std::getline(stream, description, ',');
-            std::getline(stream, when_to_do, ',');
-            std::getline(stream, deadline, ',');
-            std::getline(stream, priority, ',');
-            
-            return !(subject.empty() || description.empty() || when_to_do.empty() || deadline.empty() || priority.empty());
+            std::string line;
+            std::getline(stream, line);
+
+            RecordFields fields;
+            RecordReader::splitLine(line, fields);
+            return loadFromFields(fields);
+        }
+
+        /** 
+         * @brief Loads the task data from tokenized fields.
+         * 
+         * @param fields The fields of one record (subject, description, dates, priority).
+         * @return True if the task data is successfully loaded, false otherwise.
+         */
+        bool loadFromFields(const RecordFields& fields) override {
+            subject.assign(fields[0]);
+            description.assign(fields[1]);
+            bool validDates = loadDatesFromFields(fields, 2);
+            bool validPriority = parsePriority(fields[4], priority);
+
+            return validDates && validPriority && !(subject.empty() || description.empty());
         }
 
         /** 
@@ -97,7 +120,7 @@ namespace am {
          * @return A string representation of the task for file storage.
          */
         std::string toFileString() const override {
-            return subject + ", " + description + ", " + when_to_do + ", " + deadline + ", " + priority + "\n";
+            return subject + ", " + description + ", " + when_to_do.toString() + ", " + deadline.toString() + ", " + std::string(priorityName(priority)) + "\n";
         }
 
         const std::string& getSubject() const {
@@ -106,6 +129,17 @@ namespace am {
 
         void setSubject(const std::string& newSubject) {
             subject = newSubject;
+            dirty = true;
+        }
+
+        /** 
+         * @brief Formats the task details for the console into a frame.
+         * 
+         * @param frame The frame the task details are appended to.
+         */
+        void render(Frame& frame) const override {
+            frame.append("  Subject: ").append(subject).append('\n');
+            renderCommon(frame);
         }
 
         /** 
@@ -116,16 +150,12 @@ namespace am {
          * @return The output stream with the task details.
          */
         friend std::ostream& operator<<(std::ostream& os, const StudyTask& task) {
-            os << "  Subject: " << task.getSubject() << "\n";
-            os << "  Description: " << task.getDescription() << "\n";
-            os << "  Deadline: " << task.getDeadline() << "\n";
-            os << "  Priority: " << task.getPriority() << "\n";
-            return os;
+            Frame frame;
+            task.render(frame);
+            std::string_view text = frame.view();
+            return os.write(text.data(), static_cast<std::streamsize>(text.size()));
         }
     };
-
-    /** @brief The file path for storing study tasks. */
-    const std::string StudyTask::FILE_PATH = "study.txt";
 }
 
 
@@ -5,6 +5,11 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include "Date.hpp"
+#include "Frame.hpp"
+#include "Priority.hpp"
+#include "RecordReader.hpp"
 
 namespace am {
     /**
@@ -19,14 +24,17 @@ namespace am {
         /** @brief The description of the task. */
         std::string description;
         
-        /** @brief The date when the task should be done (DD.MM.YYYY). */
-        std::string when_to_do;
+        /** @brief The date when the task should be done. */
+        Date when_to_do;
 
-        /** @brief The deadline for the task (DD.MM.YYYY). */
-        std::string deadline;
+        /** @brief The deadline for the task. */
+        Date deadline;
 
-        /** @brief The priority of the task (low, medium, high). */
-        std::string priority;
+        /** @brief The priority of the task. */
+        Priority priority = Priority::Low;
+
+        /** @brief Whether a setter changed the task since it was created or marked clean. */
+        bool dirty = false;
 
     public:
 
@@ -39,24 +47,24 @@ namespace am {
          * @brief Constructor for creating a task with description and when-to-do date.
          * 
          * @param description The description of the task.
-         * @param when_to_do The date when the task should be done (DD.MM.YYYY).
+         * @param when_to_do The date when the task should be done.
          */
-        Task(const std::string& description, const std::string when_to_do) 
+        Task(const std::string& description, Date when_to_do) 
             : description(description), when_to_do(when_to_do) {}
             
         /** 
          * @brief Constructor for creating a task with description, when-to-do date, deadline, and priority.
          * 
          * @param description The description of the task.
-         * @param when_to_do The date when the task should be done (DD.MM.YYYY).
-         * @param deadline The deadline for the task (DD.MM.YYYY).
-         * @param priority The priority of the task (low, medium, high).
+         * @param when_to_do The date when the task should be done.
+         * @param deadline The deadline for the task.
+         * @param priority The priority of the task.
          */
         Task(
                 const std::string& description, 
-                const std::string when_to_do, 
-                const std::string& deadline, 
-                const std::string& priority)
+                Date when_to_do, 
+                Date deadline, 
+                Priority priority)
             : description(description), when_to_do(when_to_do), deadline(deadline), priority(priority) {}
 
         /** 
@@ -86,6 +94,17 @@ namespace am {
          */
         virtual bool loadFromStream(std::istringstream& ss) = 0;
 
+        /** 
+         * @brief Pure virtual method to load task data from already tokenized fields.
+         * 
+         * This is the allocation-light counterpart of `loadFromStream`, used when a whole file
+         * is tokenized in place by `RecordReader`.
+         * 
+         * @param fields The fields of one record.
+         * @return True if the task was successfully loaded, false otherwise.
+         */
+        virtual bool loadFromFields(const RecordFields& fields) = 0;
+
         /** 
          * @brief Pure virtual method to convert task data to a string suitable for file storage.
          * 
@@ -93,36 +112,105 @@ namespace am {
          */
         virtual std::string toFileString() const = 0;
 
+        /** 
+         * @brief Checks whether a text can be stored as a field of the task files.
+         * 
+         * The files separate fields with commas and records with line breaks, without any
+         * escaping, so a description, subject or assignee must contain neither.
+         * 
+         * @param text The text to check.
+         * @return True if the text reads back unchanged from a task file, false otherwise.
+         */
+        static bool isStorableText(std::string_view text) {
+            return text.find_first_of(",\r\n") == std::string_view::npos;
+        }
+
+        /** 
+         * @brief Pure virtual method to format the task details for the console into a frame.
+         * 
+         * This is the text printed by `operator<<`, formatted without going through a stream.
+         * 
+         * @param frame The frame the task details are appended to.
+         */
+        virtual void render(Frame& frame) const = 0;
+
+    protected:
+        /** 
+         * @brief Formats the description, deadline and priority lines shared by all task types.
+         * 
+         * @param frame The frame the lines are appended to.
+         */
+        void renderCommon(Frame& frame) const {
+            frame.append("  Description: ").append(description).append('\n');
+            frame.append("  Deadline: ").append(deadline).append('\n');
+            frame.append("  Priority: ").append(priority).append('\n');
+        }
+
+        /** 
+         * @brief Reads the when-to-do date and deadline from tokenized fields.
+         * 
+         * @param fields The fields of one record.
+         * @param first The index of the when-to-do field; the deadline follows it.
+         * @return True if both fields hold a valid date, false otherwise.
+         */
+        bool loadDatesFromFields(const RecordFields& fields, size_t first) {
+            return Date::parse(fields[first], when_to_do) && Date::parse(fields[first + 1], deadline);
+        }
+
+    public:
+
         const std::string& getDescription() const {
             return description;
         }
 
-        std::string getWhenToDo() const {
+        Date getWhenToDo() const {
             return when_to_do; 
         }
 
-        const std::string& getDeadline() const {
+        Date getDeadline() const {
             return deadline;
         }
 
-        const std::string& getPriority() const {
+        Priority getPriority() const {
             return priority;
         }
 
         void setDescription(const std::string& newDescription) {
             description = newDescription;
+            dirty = true;
         }
 
-        void setWhenToDo(const std::string& newWhenToDo) {
+        void setWhenToDo(Date newWhenToDo) {
             when_to_do = newWhenToDo;
+            dirty = true;
         }
 
-        void setDeadline(const std::string& newDeadline) {
+        void setDeadline(Date newDeadline) {
             deadline = newDeadline;
+            dirty = true;
         }
 
-        void setPriority(const std::string& newPriority) {
+        void setPriority(Priority newPriority) {
             priority = newPriority;
+            dirty = true;
+        }
+
+        /** 
+         * @brief Checks whether a setter changed the task since it was last marked clean.
+         * 
+         * `TaskRepository::updateTask` only persists tasks that are dirty.
+         * 
+         * @return True if the task has unsaved changes, false otherwise.
+         */
+        bool isDirty() const {
+            return dirty;
+        }
+
+        /** 
+         * @brief Marks the task as matching its stored record.
+         */
+        void markClean() {
+            dirty = false;
         }
     };
 }
@@ -0,0 +1,206 @@
+#ifndef TASK_APPENDER_HPP
+#define TASK_APPENDER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace am {
+    /**
+     * @brief How far an appended record must have travelled before `append` returns.
+     */
+    enum class Durability {
+        /** @brief The record may stay in the in-process buffer until a threshold is reached. */
+        None,
+
+        /** @brief The record has been handed to the operating system with `write`. */
+        Flush,
+
+        /** @brief The record has been written and synced to the storage device with `fsync`. */
+        Fsync
+    };
+
+    /**
+     * @class TaskAppender
+     * @brief Buffered, append-only writer for one category file.
+     *
+     * The appender keeps the file descriptor open and collects records in a buffer, so adding
+     * many tasks costs one `write` per batch instead of an open/write/close per task. The buffer
+     * is flushed when it grows past `flushBytes`, when the oldest buffered record is older than
+     * `flushInterval` at the time of the next append, when a caller asks for a stronger
+     * durability level, and when the appender is destroyed. An idle appender is not flushed on
+     * its own; `TaskRepository::flushIfDue()` covers that case.
+     */
+    class TaskAppender {
+    public:
+        /** @brief Default buffer size that triggers a flush. */
+        static constexpr size_t DEFAULT_FLUSH_BYTES = 64 * 1024;
+
+        /** @brief Default age of the oldest buffered record that triggers a flush. */
+        static constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL{1000};
+
+        /**
+         * @brief Constructor for an appender writing to the given file.
+         *
+         * The file is opened lazily on the first flush.
+         *
+         * @param filePath The path of the category file.
+         * @param flushBytes Buffer size that triggers a flush.
+         * @param flushInterval Age of the oldest buffered record that triggers a flush.
+         */
+        explicit TaskAppender(
+                const std::string& filePath,
+                size_t flushBytes = DEFAULT_FLUSH_BYTES,
+                std::chrono::milliseconds flushInterval = DEFAULT_FLUSH_INTERVAL)
+            : filePath(filePath), flushBytes(flushBytes), flushInterval(flushInterval) {}
+
+        TaskAppender(const TaskAppender&) = delete;
+        TaskAppender& operator=(const TaskAppender&) = delete;
+
+        /**
+         * @brief Flushes pending records and closes the file.
+         */
+        ~TaskAppender() {
+            flush(Durability::Flush);
+            close();
+        }
+
+        /**
+         * @brief Appends one record.
+         *
+         * @param record The record text, including its trailing newline.
+         * @param durability The durability the record must have reached when this returns.
+         * @return True if the record was accepted and, if requested, written; false on error.
+         */
+        bool append(std::string_view record, Durability durability = Durability::None) {
+            if (buffer.empty()) {
+                oldestPending = std::chrono::steady_clock::now();
+            }
+            buffer.append(record.data(), record.size());
+
+            if (durability == Durability::None && buffer.size() < flushBytes &&
+                std::chrono::steady_clock::now() - oldestPending < flushInterval) {
+                return true;
+            }
+            return flush(durability == Durability::None ? Durability::Flush : durability);
+        }
+
+        /**
+         * @brief Writes all buffered records.
+         *
+         * @param durability `Fsync` additionally syncs the file to the storage device.
+         * @return True if everything was written, false otherwise.
+         */
+        bool flush(Durability durability = Durability::Flush) {
+            if (buffer.empty() && durability != Durability::Fsync) {
+                return true;
+            }
+            if (!open()) {
+                std::cerr << "Error: Unable to open file for writing: " << filePath << "\n";
+                return false;
+            }
+
+            const char* data = buffer.data();
+            size_t remaining = buffer.size();
+            while (remaining > 0) {
+                ssize_t written = ::write(fd, data, remaining);
+                if (written <= 0) {
+                    std::cerr << "Error: Unable to write file: " << filePath << "\n";
+                    buffer.erase(0, buffer.size() - remaining);
+                    return false;
+                }
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+            buffer.clear();
+
+            if (durability == Durability::Fsync && fsync(fd) != 0) {
+                std::cerr << "Error: Unable to sync file: " << filePath << "\n";
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Drops buffered records and closes the file.
+         *
+         * Used when the file is rewritten as a whole, which already contains the buffered
+         * records; the next append reopens it.
+         */
+        void reset() {
+            buffer.clear();
+            close();
+        }
+
+        /**
+         * @brief Changes the buffer size that triggers a flush.
+         *
+         * @param bytes The new threshold in bytes.
+         */
+        void setFlushBytes(size_t bytes) {
+            flushBytes = bytes;
+        }
+
+        /**
+         * @brief Returns the number of buffered bytes not yet written.
+         *
+         * @return The pending byte count.
+         */
+        size_t pendingBytes() const {
+            return buffer.size();
+        }
+
+    private:
+        /** @brief The path of the category file. */
+        std::string filePath;
+
+        /** @brief Buffer size that triggers a flush. */
+        size_t flushBytes;
+
+        /** @brief Age of the oldest buffered record that triggers a flush. */
+        std::chrono::milliseconds flushInterval;
+
+        /** @brief Records not yet written. */
+        std::string buffer;
+
+        /** @brief When the oldest buffered record was appended. */
+        std::chrono::steady_clock::time_point oldestPending;
+
+        /** @brief Descriptor opened in append mode, or -1 while closed. */
+        int fd = -1;
+
+        bool open() {
+            if (fd >= 0) {
+                return true;
+            }
+
+            fd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+            if (fd < 0) {
+                return false;
+            }
+
+            // Terminate a last line written without a newline, so new records start on their own line.
+            struct stat info;
+            char last = '\n';
+            if (fstat(fd, &info) == 0 && info.st_size > 0 &&
+                pread(fd, &last, 1, info.st_size - 1) == 1 && last != '\n') {
+                buffer.insert(buffer.begin(), '\n');
+            }
+            return true;
+        }
+
+        void close() {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef TASK_CATEGORY_HPP
+#define TASK_CATEGORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace am {
+    /**
+     * @brief The category a task belongs to; every category is stored in its own file.
+     */
+    enum class TaskCategory : uint8_t {
+        Study = 0,
+        Life = 1,
+        Work = 2
+    };
+
+    /** @brief Number of task categories. */
+    constexpr size_t TASK_CATEGORY_COUNT = 3;
+
+    /**
+     * @brief Returns the one-letter code of a category used in log files.
+     *
+     * @param category The category.
+     * @return 's' for study, 'l' for life and 'w' for work.
+     */
+    constexpr char categoryCode(TaskCategory category) {
+        return category == TaskCategory::Study ? 's' : category == TaskCategory::Life ? 'l' : 'w';
+    }
+
+    /**
+     * @brief Parses the one-letter code of a category.
+     *
+     * @param code The code written by `categoryCode`.
+     * @param category Receives the category on success.
+     * @return True if `code` is a known category code, false otherwise.
+     */
+    constexpr bool categoryFromCode(char code, TaskCategory& category) {
+        switch (code) {
+            case 's': category = TaskCategory::Study; return true;
+            case 'l': category = TaskCategory::Life; return true;
+            case 'w': category = TaskCategory::Work; return true;
+            default: return false;
+        }
+    }
+
+    /**
+     * @brief Identifier of a task inside its category.
+     *
+     * Ids are assigned in load and insertion order and are never reused while the
+     * application is running, so they stay valid when other tasks are removed.
+     */
+    using TaskId = uint32_t;
+
+    /**
+     * @struct TaskRef
+     * @brief Reference to a single task of any category.
+     */
+    struct TaskRef {
+        /** @brief The category of the referenced task. */
+        TaskCategory category;
+
+        /** @brief The id of the task inside its category. */
+        TaskId id;
+
+        friend bool operator==(const TaskRef& lhs, const TaskRef& rhs) {
+            return lhs.category == rhs.category && lhs.id == rhs.id;
+        }
+
+        friend bool operator!=(const TaskRef& lhs, const TaskRef& rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const TaskRef& lhs, const TaskRef& rhs) {
+            return lhs.category != rhs.category ? lhs.category < rhs.category : lhs.id < rhs.id;
+        }
+    };
+}
+
+#endif
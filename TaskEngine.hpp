@@ -0,0 +1,389 @@
+#ifndef TASK_ENGINE_HPP
+#define TASK_ENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "TaskRepository.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @class TaskEngine
+     * @brief Thread-safe front of a `TaskRepository` for embedding the task engine in a server.
+     *
+     * The engine offers the operations of the interactive application (adding, completing and
+     * rescheduling tasks, and querying them by date) without any console input or output. Every
+     * method can be called from any thread: queries take a shared lock, so any number of them
+     * run in parallel, while changes take the lock exclusively and are applied one at a time.
+     * A change first reserves the write lock of the task files (see
+     * `TaskRepository::WriteReservation`), so waiting for another process never holds up
+     * queries.
+     *
+     * The task files are loaded on the first call that needs them. Tasks written by other
+     * processes are only picked up by `refresh()`, which keeps queries free of file access.
+     * A background maintenance thread writes tasks added without durability once they have
+     * waited for the flush interval and compacts the journal once it is due (see
+     * `TaskRepository::flushIfDue()` and `TaskRepository::compactIfDue()`), so neither happens
+     * inside a change.
+     */
+    class TaskEngine {
+    public:
+        /** @brief How often the maintenance thread checks for buffered tasks and the journal. */
+        static constexpr std::chrono::milliseconds MAINTENANCE_INTERVAL{250};
+
+        /**
+         * @brief Constructor starting the maintenance thread.
+         */
+        TaskEngine() : maintenance([this] { runMaintenance(); }) {}
+
+        /**
+         * @brief Destructor stopping the maintenance thread.
+         */
+        ~TaskEngine() {
+            {
+                std::lock_guard<std::mutex> lock(maintenanceMutex);
+                stopping = true;
+            }
+            maintenanceWake.notify_all();
+            maintenance.join();
+        }
+
+        TaskEngine(const TaskEngine&) = delete;
+        TaskEngine& operator=(const TaskEngine&) = delete;
+
+        /**
+         * @brief Enables binary snapshots of the task files (see `TaskRepository::setSnapshots`).
+         *
+         * @param enabled Whether snapshots are used.
+         */
+        void setSnapshots(bool enabled) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            repository.setSnapshots(enabled);
+        }
+
+        /**
+         * @brief Enables saving the date index next to the task files.
+         *
+         * @param enabled Whether the index is persisted.
+         * @see TaskRepository::setPersistentIndex()
+         */
+        void setPersistentIndex(bool enabled) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            repository.setPersistentIndex(enabled);
+        }
+
+        /**
+         * @brief Writes all pending changes and then the date index, if it is persisted.
+         *
+         * @return True if the index was written or did not need to be, false on error.
+         * @see TaskRepository::saveIndex()
+         */
+        bool saveIndex() {
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return repository.saveIndex();
+        }
+
+        /**
+         * @brief Moves writing to the files to a background I/O thread, or back.
+         *
+         * @param enabled Whether changes are written asynchronously.
+         * @see TaskRepository::setAsyncWrites()
+         */
+        void setAsyncWrites(bool enabled) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            repository.setAsyncWrites(enabled);
+        }
+
+        /**
+         * @brief Waits until every change made so far has been written to the files.
+         *
+         * Takes no lock of the engine, so queries and changes go on while it waits.
+         */
+        void waitForWrites() {
+            // The repository guards the state of its I/O thread itself.
+            repository.waitForWrites();
+        }
+
+        /**
+         * @brief Returns how many background writes failed since the last call.
+         *
+         * Includes the writes of the maintenance thread.
+         *
+         * @return The number of failed writes.
+         */
+        size_t takeWriteFailures() {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.takeWriteFailures()
+                + maintenanceFailures.exchange(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Loads the task files unless they are already in memory.
+         */
+        void load() {
+            if (loaded.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            if (!loaded.load(std::memory_order_relaxed)) {
+                repository.ensureLoaded();
+                loaded.store(true, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Loads the task files, or reads what other processes have written since.
+         *
+         * @see TaskRepository::ensureLoaded()
+         */
+        void refresh() {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            repository.ensureLoaded();
+            loaded.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Adds a task and appends it to its category file.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param task The task to add.
+         * @return True if the task was written, false on a write error.
+         */
+        template <typename T>
+        bool addTask(const T& task) {
+            load();
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return repository.addTask(task);
+        }
+
+        /**
+         * @brief Marks a task as done, removing it.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param id The id of the task, as found by a query.
+         * @return True if the task existed and its removal is durable, false otherwise.
+         */
+        template <typename T>
+        bool completeTask(TaskId id) {
+            load();
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return repository.removeTask<T>(id);
+        }
+
+        /**
+         * @brief Moves every task scheduled for one day to another day.
+         *
+         * @param from The current date of the tasks.
+         * @param to The new date.
+         * @param moved Receives the number of rescheduled tasks.
+         * @return True if the changes were written, false on a write error.
+         */
+        bool rescheduleTasks(Date from, Date to, size_t& moved) {
+            load();
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return repository.rescheduleTasks(from, to, moved);
+        }
+
+        /**
+         * @brief Returns the tasks of all categories scheduled for the given date.
+         *
+         * @param date The date to look for.
+         * @return References to the matching tasks, ordered by category and file order.
+         */
+        std::vector<TaskRef> findTasksForDate(Date date) {
+            load();
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.findTasksForDate(date);
+        }
+
+        /**
+         * @brief Returns the tasks of a category scheduled for the given date.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param date The date to look for.
+         * @return Copies of the matching tasks in file order.
+         */
+        template <typename T>
+        std::vector<T> getTasksForDate(Date date) {
+            load();
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.getTasksForDate<T>(date);
+        }
+
+        /**
+         * @brief Returns the tasks of a category scheduled within a date range.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param first The first day of the range.
+         * @param last The last day of the range (inclusive).
+         * @return Copies of the matching tasks ordered by date.
+         */
+        template <typename T>
+        std::vector<T> getTasksBetween(Date first, Date last) {
+            load();
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.getTasksBetween<T>(first, last);
+        }
+
+        /**
+         * @brief Returns the most urgent tasks of all categories.
+         *
+         * Only the first call takes the lock exclusively, to build the agenda; from then on the
+         * agenda is kept up to date and queries run under the shared lock.
+         *
+         * @param count The maximum number of tasks to return.
+         * @return Up to `count` agenda entries, most urgent first.
+         * @see TaskRepository::getAgenda()
+         */
+        std::vector<Agenda::Entry> getAgenda(size_t count) {
+            load();
+            if (!agendaReady.load(std::memory_order_acquire)) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                repository.buildAgenda();
+                agendaReady.store(true, std::memory_order_release);
+            }
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.getAgenda(count);
+        }
+
+        /**
+         * @brief Finds the tasks whose description, subject or assignee contain every query word.
+         *
+         * Only the first call takes the lock exclusively, to build the search index; from then
+         * on the index is kept up to date and searches run under the shared lock.
+         *
+         * @param query The words to look for; `*` after a word makes it a prefix.
+         * @return References to the matching tasks, ordered by category and file order.
+         * @see TaskRepository::search()
+         */
+        std::vector<TaskRef> search(std::string_view query) {
+            load();
+            if (!searchable.load(std::memory_order_acquire)) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                repository.buildSearchIndex();
+                searchable.store(true, std::memory_order_release);
+            }
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return repository.search(query);
+        }
+
+        /**
+         * @brief Runs a read-only function on the repository under the shared lock.
+         *
+         * Used to read several tasks consistently, e.g. to render a page, without copying them.
+         * References obtained inside `reader` must not be kept after it returns.
+         *
+         * @tparam Reader A callable taking a `const TaskRepository&`.
+         * @param reader The function to run.
+         * @return Whatever `reader` returns.
+         */
+        template <typename Reader>
+        decltype(auto) read(Reader&& reader) {
+            load();
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return std::forward<Reader>(reader)(static_cast<const TaskRepository&>(repository));
+        }
+
+        /**
+         * @brief Runs a function that changes the repository under the exclusive lock.
+         *
+         * Used to apply a batch of changes as one step, e.g. by `TaskIngestor`.
+         *
+         * @tparam Writer A callable taking a `TaskRepository&`.
+         * @param writer The function to run.
+         * @return Whatever `writer` returns.
+         */
+        template <typename Writer>
+        decltype(auto) write(Writer&& writer) {
+            load();
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return std::forward<Writer>(writer)(repository);
+        }
+
+    private:
+        /** @brief Guards `repository`: shared for queries, exclusive for changes. */
+        std::shared_mutex mutex;
+
+        /** @brief The in-memory tasks. */
+        TaskRepository repository;
+
+        /** @brief Whether `repository` has been loaded, checked without taking `mutex`. */
+        std::atomic<bool> loaded{false};
+
+        /** @brief Whether the agenda of `repository` has been built. */
+        std::atomic<bool> agendaReady{false};
+
+        /** @brief Whether the search index of `repository` has been built. */
+        std::atomic<bool> searchable{false};
+
+        /** @brief Number of failed writes of the maintenance thread not yet taken. */
+        std::atomic<size_t> maintenanceFailures{0};
+
+        /** @brief Guards `stopping`. */
+        std::mutex maintenanceMutex;
+
+        /** @brief Wakes the maintenance thread early to stop it. */
+        std::condition_variable maintenanceWake;
+
+        /** @brief Whether the maintenance thread should exit. */
+        bool stopping = false;
+
+        /** @brief Flushes buffered tasks and compacts when due; started last, joined first. */
+        std::thread maintenance;
+
+        void runMaintenance() {
+            std::unique_lock<std::mutex> lock(maintenanceMutex);
+            while (!maintenanceWake.wait_for(lock, MAINTENANCE_INTERVAL, [this] { return stopping; })) {
+                lock.unlock();
+                if (loaded.load(std::memory_order_acquire)) {
+                    flushIfDue();
+                    compactIfDue();
+                }
+                lock.lock();
+            }
+        }
+
+        void flushIfDue() {
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                if (!repository.isFlushDue()) {
+                    return;
+                }
+            }
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            if (!repository.flushIfDue()) {
+                maintenanceFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void compactIfDue() {
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                if (!repository.isCompactionDue()) {
+                    return;
+                }
+            }
+            TaskRepository::WriteReservation reservation(repository);
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            if (!repository.compactIfDue()) {
+                maintenanceFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,22 @@
+/**
+ * @file TaskFiles.cpp
+ * @brief Definitions of the static members shared by every translation unit of the task engine.
+ *
+ * The task headers only declare these members, so they can be included from any number of
+ * source files that are linked into one program.
+ */
+
+#include "LifeTask.hpp"
+#include "StudyTask.hpp"
+#include "WorkTask.hpp"
+
+namespace am {
+    /** @brief The file path for storing study tasks. */
+    const std::string StudyTask::FILE_PATH = "study.txt";
+
+    /** @brief The file path for storing life tasks. */
+    const std::string LifeTask::FILE_PATH = "life.txt";
+
+    /** @brief The file path for storing work tasks. */
+    const std::string WorkTask::FILE_PATH = "work.txt";
+}
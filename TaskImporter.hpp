@@ -0,0 +1,146 @@
+#ifndef TASK_IMPORTER_HPP
+#define TASK_IMPORTER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "RecordReader.hpp"
+#include "TaskJournal.hpp"
+#include "TaskRepository.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @struct ImportReport
+     * @brief Outcome of a bulk import.
+     */
+    struct ImportReport {
+        /** @brief Number of non-empty input rows. */
+        size_t rows = 0;
+
+        /** @brief Number of rows added as new tasks. */
+        size_t imported = 0;
+
+        /** @brief Number of rows rejected for their number of fields, a bad date or priority. */
+        size_t invalid = 0;
+
+        /** @brief Number of rows skipped because the same task already exists. */
+        size_t duplicates = 0;
+
+        /** @brief Number of valid rows that could not be written because of a write error. */
+        size_t failed = 0;
+
+        /** @brief Whether the imported tasks were flushed and synced to the category file. */
+        bool written = true;
+
+        /** @brief Wall-clock duration of the import in seconds. */
+        double seconds = 0.0;
+
+        /**
+         * @brief Checks whether every row was imported and written, or skipped as a duplicate.
+         *
+         * @return True if the import succeeded completely.
+         */
+        bool succeeded() const {
+            return invalid == 0 && failed == 0 && written;
+        }
+
+        /**
+         * @brief Returns the import throughput.
+         *
+         * @return Input rows processed per second.
+         */
+        double rowsPerSecond() const {
+            return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @class TaskImporter
+     * @brief Non-interactive bulk import of tasks into a repository.
+     *
+     * The input uses the same comma-separated schema as the category files, so every row is
+     * parsed by the task's own `loadFromFields`. Rows with invalid dates or priorities are
+     * rejected, and so are rows with more or fewer fields than the schema, since the files
+     * cannot store a comma inside a field. Rows identical to an existing or previously imported
+     * task are skipped, and the accepted tasks are appended through large buffered writes that
+     * are synced once at the end.
+     */
+    class TaskImporter {
+    public:
+        /** @brief Append buffer size used while importing. */
+        static constexpr size_t IMPORT_BUFFER_BYTES = 1024 * 1024;
+
+        /**
+         * @brief Constructor for an importer writing into the given repository.
+         *
+         * @param repository The repository that receives the imported tasks.
+         */
+        explicit TaskImporter(TaskRepository& repository)
+            : repository(repository) {}
+
+        /**
+         * @brief Imports all rows of a text buffer as tasks of one category.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param text The input rows, one task per line.
+         * @return Counters and timing of the import.
+         */
+        template <typename T>
+        ImportReport importTasks(std::string_view text) {
+            auto start = std::chrono::steady_clock::now();
+            ImportReport report;
+
+            repository.ensureLoaded();
+            repository.setAppendBufferSize(IMPORT_BUFFER_BYTES);
+
+            std::unordered_set<uint64_t> known;
+            const TaskTable<T>& existing = repository.getTasks<T>();
+            known.reserve(existing.size());
+            for (TaskId id : existing.liveIds()) {
+                known.insert(TaskJournal::fingerprint(existing.get(id).toFileString()));
+            }
+
+            RecordReader reader(text);
+            RecordFields fields;
+            T task;
+            while (reader.next(fields)) {
+                if (fields.count == 1 && fields[0].empty()) {
+                    continue;
+                }
+                ++report.rows;
+
+                if (fields.count != T::FIELD_COUNT || !task.loadFromFields(fields)) {
+                    ++report.invalid;
+                    continue;
+                }
+                if (!known.insert(TaskJournal::fingerprint(task.toFileString())).second) {
+                    ++report.duplicates;
+                    continue;
+                }
+
+                if (!repository.addTask(task, Durability::None)) {
+                    ++report.failed;
+                    continue;
+                }
+                ++report.imported;
+            }
+
+            report.written = repository.flush(Durability::Fsync);
+            repository.setAppendBufferSize(TaskAppender::DEFAULT_FLUSH_BYTES);
+
+            auto end = std::chrono::steady_clock::now();
+            report.seconds = std::chrono::duration<double>(end - start).count();
+            return report;
+        }
+
+    private:
+        /** @brief The repository that receives the imported tasks. */
+        TaskRepository& repository;
+    };
+}
+
+#endif
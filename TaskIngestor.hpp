@@ -0,0 +1,270 @@
+#ifndef TASK_INGESTOR_HPP
+#define TASK_INGESTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+#include "MpscQueue.hpp"
+#include "TaskEngine.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @brief A fully built task of any category, as queued by `TaskIngestor`.
+     */
+    using AnyTask = std::variant<StudyTask, LifeTask, WorkTask>;
+
+    /**
+     * @struct IngestStats
+     * @brief Counters of a `TaskIngestor`.
+     */
+    struct IngestStats {
+        /** @brief Number of tasks queued but not yet committed. */
+        size_t queueDepth = 0;
+
+        /** @brief Largest queue depth seen by the writer before a batch. */
+        size_t maxQueueDepth = 0;
+
+        /** @brief Number of committed batches. */
+        size_t batches = 0;
+
+        /** @brief Number of committed tasks. */
+        size_t tasks = 0;
+
+        /** @brief Number of tasks in the most recent batch. */
+        size_t lastBatchSize = 0;
+
+        /** @brief Largest batch committed so far. */
+        size_t maxBatchSize = 0;
+
+        /** @brief Number of batches that could not be written completely. */
+        size_t failedBatches = 0;
+
+        /** @brief Duration of the most recent commit until it was written, in milliseconds. */
+        double lastCommitMs = 0.0;
+
+        /** @brief Longest commit so far in milliseconds. */
+        double maxCommitMs = 0.0;
+
+        /** @brief Total time spent committing in milliseconds. */
+        double totalCommitMs = 0.0;
+
+        /**
+         * @brief Returns the average number of tasks per batch.
+         *
+         * @return Tasks per batch, or 0 before the first batch.
+         */
+        double averageBatchSize() const {
+            return batches > 0 ? static_cast<double>(tasks) / static_cast<double>(batches) : 0.0;
+        }
+
+        /**
+         * @brief Returns the average commit latency.
+         *
+         * @return Milliseconds per batch, or 0 before the first batch.
+         */
+        double averageCommitMs() const {
+            return batches > 0 ? totalCommitMs / static_cast<double>(batches) : 0.0;
+        }
+    };
+
+    /**
+     * @class TaskIngestor
+     * @brief Accepts new tasks from many threads and writes them from one writer thread.
+     *
+     * Producers hand over fully built tasks through a lock-free `MpscQueue` and return at once.
+     * The writer thread takes everything queued so far, up to `MAX_BATCH` tasks, and adds the
+     * batch to the `TaskEngine` under a single exclusive lock. The tasks of the batch are
+     * buffered by the appenders and written with one flush per category file (group commit),
+     * so concurrent producers never interleave partial records or contend for the files. With
+     * asynchronous writes enabled on the engine, the writer waits for the I/O thread, so a
+     * batch is only counted as committed (and timed) once it is written; a failure of that
+     * write is reported by `TaskEngine::takeWriteFailures()` rather than as a failed batch.
+     *
+     * `waitUntilCommitted()` is a barrier for everything queued before it; the destructor
+     * commits all queued tasks before stopping the writer.
+     */
+    class TaskIngestor {
+    public:
+        /** @brief Largest number of tasks committed as one batch. */
+        static constexpr size_t MAX_BATCH = 4096;
+
+        /**
+         * @brief Starts the writer thread.
+         *
+         * @param engine The engine the tasks are added to.
+         * @param durability How far every batch is written before it counts as committed.
+         */
+        explicit TaskIngestor(TaskEngine& engine, Durability durability = Durability::Flush)
+            : engine(engine), durability(durability), writer([this] { run(); }) {}
+
+        TaskIngestor(const TaskIngestor&) = delete;
+        TaskIngestor& operator=(const TaskIngestor&) = delete;
+
+        /**
+         * @brief Commits the queued tasks and stops the writer thread.
+         */
+        ~TaskIngestor() {
+            stopping.store(true);
+            wake();
+            writer.join();
+        }
+
+        /**
+         * @brief Queues a task; may be called from any thread and never blocks on the files.
+         *
+         * @param task The task to add.
+         */
+        void submit(AnyTask task) {
+            // Counted before it is linked, so `waitUntilCommitted` never misses a queued task.
+            enqueued.fetch_add(1, std::memory_order_seq_cst);
+            queue.push(std::move(task));
+            // Pairs with `run`, which sets `idle` before reading `enqueued`: either the writer
+            // sees the new count or this sees it idle.
+            if (idle.load(std::memory_order_seq_cst)) {
+                wake();
+            }
+        }
+
+        /**
+         * @brief Waits until every task submitted before this call has been committed.
+         */
+        void waitUntilCommitted() {
+            size_t target = enqueued.load();
+            std::unique_lock<std::mutex> lock(mutex);
+            progress.wait(lock, [this, target] { return committed >= target; });
+        }
+
+        /**
+         * @brief Returns the current counters.
+         *
+         * @return A copy of the statistics, including the current queue depth.
+         */
+        IngestStats getStats() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            IngestStats current = stats;
+            current.queueDepth = enqueued.load() - committed;
+            return current;
+        }
+
+    private:
+        /** @brief The engine the tasks are added to. */
+        TaskEngine& engine;
+
+        /** @brief How far every batch is written before it counts as committed. */
+        Durability durability;
+
+        /** @brief Tasks submitted but not yet taken by the writer. */
+        MpscQueue<AnyTask> queue;
+
+        /** @brief Number of tasks ever submitted. */
+        std::atomic<size_t> enqueued{0};
+
+        /** @brief Whether the writer is about to sleep or sleeping. */
+        std::atomic<bool> idle{false};
+
+        /** @brief Set by the destructor to stop the writer once the queue is empty. */
+        std::atomic<bool> stopping{false};
+
+        /** @brief Guards `committed`, `stats` and the sleep of the writer. */
+        mutable std::mutex mutex;
+
+        /** @brief Wakes the writer when tasks arrive. */
+        std::condition_variable ready;
+
+        /** @brief Wakes `waitUntilCommitted` callers after a batch. */
+        std::condition_variable progress;
+
+        /** @brief Number of tasks committed (or given up on after a write error). */
+        size_t committed = 0;
+
+        /** @brief Counters reported by `getStats`. */
+        IngestStats stats;
+
+        /** @brief The thread that writes the batches; started last. */
+        std::thread writer;
+
+        void wake() {
+            // Taking the mutex orders this notification after the writer's last look at the queue.
+            { std::lock_guard<std::mutex> lock(mutex); }
+            ready.notify_one();
+        }
+
+        void run() {
+            std::vector<AnyTask> batch;
+            batch.reserve(MAX_BATCH);
+            while (true) {
+                AnyTask task;
+                while (batch.size() < MAX_BATCH && queue.pop(task)) {
+                    batch.push_back(std::move(task));
+                }
+                if (!batch.empty()) {
+                    commit(batch);
+                    batch.clear();
+                    continue;
+                }
+                if (stopping.load() && enqueued.load() == committedCount()) {
+                    return;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex);
+                idle.store(true, std::memory_order_seq_cst);
+                // A task submitted after the check above is either counted here or wakes the
+                // writer; one counted but not linked yet is picked up by the next round.
+                ready.wait_for(lock, std::chrono::milliseconds(100), [this] {
+                    return enqueued.load(std::memory_order_seq_cst) != committed || stopping.load();
+                });
+                idle.store(false);
+            }
+        }
+
+        size_t committedCount() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return committed;
+        }
+
+        void commit(const std::vector<AnyTask>& batch) {
+            size_t depth = enqueued.load() - committedCount();
+            auto start = std::chrono::steady_clock::now();
+            bool written = engine.write([this, &batch](TaskRepository& repository) {
+                bool accepted = true;
+                for (const AnyTask& task : batch) {
+                    std::visit([&](const auto& typed) {
+                        accepted &= repository.addTask(typed, Durability::None);
+                    }, task);
+                }
+                return repository.flush(durability) && accepted;
+            });
+            // With asynchronous writes the flush above was only queued; the batch counts as
+            // committed once the I/O thread has written it.
+            engine.waitForWrites();
+            auto end = std::chrono::steady_clock::now();
+            double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                committed += batch.size();
+                ++stats.batches;
+                stats.tasks += batch.size();
+                stats.lastBatchSize = batch.size();
+                stats.maxBatchSize = std::max(stats.maxBatchSize, batch.size());
+                stats.maxQueueDepth = std::max(stats.maxQueueDepth, depth);
+                stats.lastCommitMs = milliseconds;
+                stats.maxCommitMs = std::max(stats.maxCommitMs, milliseconds);
+                stats.totalCommitMs += milliseconds;
+                if (!written) {
+                    ++stats.failedBatches;
+                }
+            }
+            progress.notify_all();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef TASK_JOURNAL_HPP
+#define TASK_JOURNAL_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "Date.hpp"
+#include "MappedFile.hpp"
+#include "RecordReader.hpp"
+#include "TaskCategory.hpp"
+
+namespace am {
+    /**
+     * @struct JournalEntry
+     * @brief One change recorded in the task journal.
+     */
+    struct JournalEntry {
+        /**
+         * @brief The kind of change.
+         */
+        enum class Type : char {
+            /** @brief The task was marked as done and must be dropped on load. */
+            Remove = 'D',
+
+            /** @brief The task's when-to-do date was changed to `date`. */
+            Reschedule = 'R',
+
+            /** @brief The task's record was replaced by `record`. */
+            Update = 'U'
+        };
+
+        /** @brief The kind of change. */
+        Type type;
+
+        /** @brief The category file the change applies to. */
+        TaskCategory category;
+
+        /** @brief Zero-based line of the affected record in its category file. */
+        uint32_t line;
+
+        /** @brief Fingerprint of the affected record, used to reject entries for other records. */
+        uint64_t fingerprint;
+
+        /** @brief The new when-to-do date of a `Reschedule` entry. */
+        Date date;
+
+        /** @brief The new record of an `Update` entry, without its trailing newline. */
+        std::string record;
+    };
+
+    /**
+     * @class TaskJournal
+     * @brief Append-only log of changes to the task files.
+     *
+     * Instead of rewriting a whole category file to drop or reschedule one task, the change is
+     * appended to the journal as a small entry and synced to disk. A batch of entries, such as
+     * all tasks rescheduled at once, is written with a single write and a single sync. The
+     * entries are applied on the next load and folded into the category files by a compaction
+     * step, after which the journal is emptied.
+     *
+     * Every entry carries a fingerprint of the record it refers to, so entries that no longer
+     * match the file (for example after an interrupted compaction) are ignored rather than
+     * applied to the wrong task. An edited task is logged as an `Update` entry holding its whole
+     * new record; later entries for the same task carry the fingerprint of that new record.
+     */
+    class TaskJournal {
+    public:
+        /** @brief Default location of the journal file. */
+        static constexpr const char* FILE_PATH = "tasks.journal";
+
+        /**
+         * @brief Constructor for a journal stored at the given path.
+         *
+         * @param filePath The path of the journal file.
+         */
+        explicit TaskJournal(const std::string& filePath = FILE_PATH)
+            : filePath(filePath) {}
+
+        TaskJournal(const TaskJournal&) = delete;
+        TaskJournal& operator=(const TaskJournal&) = delete;
+
+        /**
+         * @brief Closes the journal file.
+         */
+        ~TaskJournal() {
+            close();
+        }
+
+        /**
+         * @brief Appends an entry and syncs it to disk.
+         *
+         * @param entry The change to record.
+         * @return True if the entry is durable, false otherwise.
+         */
+        bool append(const JournalEntry& entry) {
+            return append(&entry, 1);
+        }
+
+        /**
+         * @brief Appends a batch of entries with one write and one sync.
+         *
+         * @param batch The changes to record, in order.
+         * @return True if all entries are durable, false otherwise.
+         */
+        bool append(const std::vector<JournalEntry>& batch) {
+            return batch.empty() || append(batch.data(), batch.size());
+        }
+
+        /**
+         * @brief Reads every entry of the journal.
+         *
+         * Malformed lines, such as a torn final write, are skipped.
+         *
+         * @tparam Callback A callable taking a `const JournalEntry&`.
+         * @param apply Called once per entry, in the order the entries were written.
+         * @return The number of entries read.
+         */
+        template <typename Callback>
+        size_t replay(Callback&& apply) {
+            entries = 0;
+            knownBytes = 0;
+            readFrom(0, apply);
+            return entries;
+        }
+
+        /**
+         * @brief Reads the entries other processes appended since the journal was last read or written.
+         *
+         * Only complete lines are read; an entry still being written is left for the next call.
+         *
+         * @tparam Callback A callable taking a `const JournalEntry&`.
+         * @param apply Called once per new entry, in the order the entries were written.
+         * @return False if the journal is shorter than what was already read, i.e. it was
+         *         emptied by a compaction; true otherwise.
+         */
+        template <typename Callback>
+        bool catchUp(Callback&& apply) {
+            struct stat info;
+            if (stat(filePath.c_str(), &info) == 0 && static_cast<size_t>(info.st_size) == knownBytes) {
+                return true;
+            }
+            return readFrom(knownBytes, apply);
+        }
+
+        /**
+         * @brief Empties the journal after its entries were folded into the task files.
+         *
+         * @return True if the journal was truncated, false otherwise.
+         */
+        bool clear() {
+            close();
+            int truncated = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (truncated < 0) {
+                std::cerr << "Error: Unable to truncate journal: " << filePath << "\n";
+                return false;
+            }
+            fsync(truncated);
+            ::close(truncated);
+            entries = 0;
+            knownBytes = 0;
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of entries currently in the journal.
+         *
+         * @return The entry count since the last replay or clear.
+         */
+        size_t size() const {
+            return entries;
+        }
+
+        /**
+         * @brief Computes the fingerprint of a record (64-bit FNV-1a).
+         *
+         * @param record The record text, as produced by `toFileString()`.
+         * @return The fingerprint.
+         */
+        static uint64_t fingerprint(std::string_view record) {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : record) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+    private:
+        /** @brief The path of the journal file. */
+        std::string filePath;
+
+        /** @brief Descriptor used for appending, or -1 while closed. */
+        int fd = -1;
+
+        /** @brief Number of entries in the journal. */
+        size_t entries = 0;
+
+        /** @brief Length of the part of the journal this object has read or written. */
+        size_t knownBytes = 0;
+
+        template <typename Callback>
+        bool readFrom(size_t offset, Callback& apply) {
+            MappedFile file;
+            if (!file.open(filePath)) {
+                return offset == 0;
+            }
+            std::string_view text = file.data();
+            if (text.size() < offset) {
+                return false;
+            }
+
+            size_t end = text.rfind('\n');
+            if (end == std::string_view::npos || end < offset) {
+                return true;
+            }
+
+            RecordReader reader(text.substr(offset, end + 1 - offset));
+            RecordFields fields;
+            while (reader.next(fields)) {
+                JournalEntry entry;
+                if (parse(fields, entry)) {
+                    apply(entry);
+                    ++entries;
+                }
+            }
+            knownBytes = end + 1;
+            return true;
+        }
+
+        bool append(const JournalEntry* batch, size_t count) {
+            std::string buffer;
+            buffer.reserve(count * 48);
+            for (size_t i = 0; i < count; ++i) {
+                format(batch[i], buffer);
+            }
+
+            if (!openForAppend() || !writeAll(buffer.data(), buffer.size()) || fsync(fd) != 0) {
+                std::cerr << "Error: Unable to write journal: " << filePath << "\n";
+                return false;
+            }
+            entries += count;
+            knownBytes += buffer.size();
+            return true;
+        }
+
+        static void format(const JournalEntry& entry, std::string& buffer) {
+            char line[64];
+            int length = std::snprintf(line, sizeof(line), "%c %c %u %016llx",
+                static_cast<char>(entry.type), categoryCode(entry.category),
+                static_cast<unsigned>(entry.line), static_cast<unsigned long long>(entry.fingerprint));
+            buffer.append(line, static_cast<size_t>(length));
+
+            if (entry.type == JournalEntry::Type::Reschedule) {
+                char date[Date::TEXT_LENGTH];
+                buffer += ' ';
+                buffer.append(date, entry.date.format(date));
+            } else if (entry.type == JournalEntry::Type::Update) {
+                buffer += ' ';
+                buffer += entry.record;
+            }
+            buffer += '\n';
+        }
+
+        bool openForAppend() {
+            if (fd < 0) {
+                fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+            }
+            return fd >= 0;
+        }
+
+        void close() {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        bool writeAll(const char* data, size_t length) {
+            while (length > 0) {
+                ssize_t written = ::write(fd, data, length);
+                if (written <= 0) {
+                    return false;
+                }
+                data += written;
+                length -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+
+        static bool parse(const RecordFields& fields, JournalEntry& entry) {
+            // Layout: "<type> <category> <line> <fingerprint>[ <date>| <record>]". The fields of
+            // an update's record follow the first one, which shares the journal's first field.
+            std::string_view text = fields[0];
+            if (text.size() < 7 || text[1] != ' ' || text[3] != ' ' ||
+                (text[0] != 'D' && text[0] != 'R' && text[0] != 'U')) {
+                return false;
+            }
+            entry.type = static_cast<JournalEntry::Type>(text[0]);
+            if (!categoryFromCode(text[2], entry.category)) {
+                return false;
+            }
+
+            size_t position = 4;
+            uint64_t line = 0;
+            if (!readNumber(text, position, 10, line) || line > UINT32_MAX || position >= text.size()) {
+                return false;
+            }
+            entry.line = static_cast<uint32_t>(line);
+
+            ++position;
+            if (!readNumber(text, position, 16, entry.fingerprint)) {
+                return false;
+            }
+
+            if (entry.type == JournalEntry::Type::Reschedule) {
+                return position < text.size() && Date::parse(text.substr(position + 1), entry.date);
+            }
+            if (entry.type == JournalEntry::Type::Update) {
+                if (position >= text.size()) {
+                    return false;
+                }
+                entry.record.assign(text.substr(position + 1));
+                for (size_t field = 1; field < fields.count; ++field) {
+                    entry.record += ", ";
+                    entry.record.append(fields[field].data(), fields[field].size());
+                }
+                return true;
+            }
+            return position == text.size();
+        }
+
+        static bool readNumber(std::string_view text, size_t& position, unsigned base, uint64_t& value) {
+            size_t start = position;
+            value = 0;
+            while (position < text.size() && text[position] != ' ') {
+                char c = text[position];
+                unsigned digit;
+                if (c >= '0' && c <= '9') {
+                    digit = static_cast<unsigned>(c - '0');
+                } else if (base == 16 && c >= 'a' && c <= 'f') {
+                    digit = static_cast<unsigned>(c - 'a' + 10);
+                } else {
+                    return false;
+                }
+                value = value * base + digit;
+                ++position;
+            }
+            return position > start;
+        }
+    };
+}
+
+#endif
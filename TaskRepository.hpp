@@ -0,0 +1,1487 @@
+#ifndef TASK_REPOSITORY_HPP
+#define TASK_REPOSITORY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "Agenda.hpp"
+#include "Date.hpp"
+#include "DateIndex.hpp"
+#include "FileLock.hpp"
+#include "StudyTask.hpp"
+#include "WorkTask.hpp"
+#include "LifeTask.hpp"
+#include "SearchIndex.hpp"
+#include "TaskAppender.hpp"
+#include "TaskCategory.hpp"
+#include "TaskJournal.hpp"
+#include "TaskSnapshot.hpp"
+#include "TaskTable.hpp"
+#include "TaskStorage.hpp"
+#include "ThreadPool.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @class TaskRepository
+     * @brief Long-lived in-memory store for study, life and work tasks.
+     *
+     * The repository reads the three task files once and then serves every query from memory.
+     * Adding, marking as done and rescheduling are applied to the in-memory tables first and then
+     * written back through `TaskStorage`, so the files never have to be re-parsed while the
+     * application is running.
+     *
+     * All tasks are indexed by their when-to-do date in a `DateIndex`, so looking up the tasks
+     * of one day or a date range never touches tasks scheduled for other days. The `Agenda`
+     * ordering by deadline and priority is built by `buildAgenda()` and kept up to date from
+     * then on, and so is the `SearchIndex` of the words of every task used by `search()`.
+     *
+     * New tasks are appended to their category file through a buffered `TaskAppender`, which
+     * keeps the file open and writes records in batches. Marking a task as done or rescheduling
+     * it appends an entry to the `TaskJournal` instead of rewriting the category file. Edits made
+     * through the task setters are passed to `updateTask`, kept as dirty rows and written as
+     * journal entries for just the changed records by `flushChanges()`. The journal is applied
+     * on load and folded into the files by `compact()`, which `compactIfDue()` runs once the
+     * journal holds `COMPACTION_THRESHOLD` entries; no change waits for a compaction.
+     *
+     * Several TaskManager processes can share the same files. Every write takes the advisory
+     * lock `WRITE_LOCK_PATH` exclusively and first reads what other sessions appended to the
+     * category files and the journal since this session last looked, so line numbers and
+     * fingerprints always refer to the current files. Queries never lock; `refresh()` reads the
+     * new records without waiting for writers. If another session already committed a change to
+     * a task this session has edited but not flushed, the committed change wins and the local
+     * edit is discarded with a message. Every open session holds `SESSION_LOCK_PATH` shared, and
+     * a compaction, which replaces the files by renaming fully written temporary files over
+     * them, only runs once it can take that lock exclusively; otherwise it is deferred and the
+     * journal keeps growing until the other sessions have closed.
+     *
+     * With `setAsyncWrites(true)` the in-memory tables, the index and the agenda are still
+     * changed at once, but appending records and journal entries runs on a background I/O
+     * thread in the order the changes were made, so the caller never waits for the disk. The
+     * write lock stays held until the I/O thread has finished, failed writes are counted for
+     * `takeWriteFailures()`, and `waitForWrites()` is the barrier used before exiting.
+     */
+    class TaskRepository {
+    public:
+        /** @brief Default location of the optional date index file. */
+        static constexpr const char* INDEX_FILE_PATH = "tasks.idx";
+
+        /** @brief Number of journal entries after which the journal is compacted. */
+        static constexpr size_t COMPACTION_THRESHOLD = 1024;
+
+        /** @brief Lock file held exclusively by the session that is writing. */
+        static constexpr const char* WRITE_LOCK_PATH = "tasks.lock";
+
+        /** @brief Lock file held shared by every open session. */
+        static constexpr const char* SESSION_LOCK_PATH = "tasks.session";
+
+        /** @brief Pause before trying again to take a write lock held by another session. */
+        static constexpr std::chrono::milliseconds WRITE_LOCK_RETRY{2};
+
+        /**
+         * @class WriteReservation
+         * @brief Holds the write lock of the task files ahead of a change.
+         *
+         * Used by callers that serialize changes with a lock of their own, such as `TaskEngine`:
+         * taking a reservation before that lock means waiting for other sessions does not hold
+         * up anything in this process. The change itself still catches up with the other
+         * sessions when it starts.
+         */
+        class WriteReservation {
+        public:
+            explicit WriteReservation(TaskRepository& repository)
+                : repository(repository) {
+                repository.reserveWrite();
+            }
+
+            WriteReservation(const WriteReservation&) = delete;
+            WriteReservation& operator=(const WriteReservation&) = delete;
+
+            ~WriteReservation() {
+                repository.endReservation();
+            }
+
+        private:
+            TaskRepository& repository;
+        };
+
+        /**
+         * @brief Writes the changes still pending from `updateTask` and the appenders.
+         */
+        ~TaskRepository() {
+            if (loaded) {
+                flushChanges();
+                flush();
+            }
+            waitForWrites();
+        }
+
+        /**
+         * @brief Moves writing to the files to a background I/O thread, or back.
+         *
+         * @param enabled Whether changes are written asynchronously.
+         */
+        void setAsyncWrites(bool enabled) {
+            if (enabled && !io) {
+                io = std::make_unique<ThreadPool>(1);
+            } else if (!enabled && io) {
+                waitForWrites();
+                io.reset();
+            }
+        }
+
+        /**
+         * @brief Waits until the I/O thread has written every change made so far.
+         */
+        void waitForWrites() {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            writesDone.wait(lock, [this] { return outstandingWrites == 0; });
+        }
+
+        /**
+         * @brief Returns how many background writes failed since the last call.
+         *
+         * The failed writes themselves have been reported on `std::cerr` by the writer.
+         *
+         * @return The number of failed writes.
+         */
+        size_t takeWriteFailures() {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            size_t failures = writeFailures;
+            writeFailures = 0;
+            return failures;
+        }
+
+        /**
+         * @brief Loads all task files unless they are already in memory.
+         *
+         * The first call reads study.txt, life.txt and work.txt in parallel on a thread pool
+         * (each large file is split into chunks parsed concurrently), applies the journal, builds the
+         * date index and records how long it took. With snapshots enabled, a category whose file
+         * is unchanged since its snapshot was written is read from the snapshot instead. Every later call
+         * only reads what other sessions have appended since (see `refresh()`) and is counted as
+         * an avoided reload.
+         *
+         * @see getLoadTimeMs()
+         * @see getAvoidedReloads()
+         */
+        void ensureLoaded() {
+            if (loaded) {
+                ++avoidedReloads;
+                refresh();
+                return;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            // Waits only while another session is compacting; afterwards no file is replaced
+            // as long as this session is open.
+            sessionLock.lockShared();
+            loadAll();
+            loaded = true;
+            refresh();
+            auto end = std::chrono::steady_clock::now();
+
+            loadTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        /**
+         * @brief Reads the tasks and journal entries other sessions have written since this
+         *        session last read or wrote the files.
+         *
+         * The write lock of the files is not taken, so this never waits for another session;
+         * records still being written are picked up by the next call. Only the mutex guarding
+         * the state this session shares with its I/O thread is held while reading.
+         */
+        void refresh() {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            // While this session holds the write lock, nobody else can have written anything
+            // since it caught up.
+            if (loaded && (writeLock.getMode() != FileLock::Mode::Exclusive || needsCatchUp)) {
+                needsCatchUp = false;
+                catchUp();
+            }
+        }
+
+        /**
+         * @brief Enables saving the date index next to the task files.
+         *
+         * When enabled, `ensureLoaded()` reuses a saved index if the task files have not changed
+         * since it was written, and `saveIndex()` writes the current index.
+         *
+         * @param enabled Whether the index should be persisted.
+         * @param filePath The path of the index file.
+         */
+        void setPersistentIndex(bool enabled, const std::string& filePath = INDEX_FILE_PATH) {
+            persistentIndex = enabled;
+            indexFilePath = filePath;
+        }
+
+        /**
+         * @brief Enables keeping a binary snapshot next to every category file.
+         *
+         * When enabled, `ensureLoaded()` reads a category from its snapshot if the text file has
+         * not changed since the snapshot was written, and writes a new snapshot whenever it had
+         * to parse the text file or a compaction rewrote it.
+         *
+         * @param enabled Whether snapshots are used.
+         */
+        void setSnapshots(bool enabled) {
+            snapshots = enabled;
+        }
+
+        /**
+         * @brief Writes the date index to disk if index persistence is enabled.
+         *
+         * All pending changes are written first, and the index is saved under the write lock,
+         * so it describes exactly the files it is signed with. It is not saved after a
+         * compaction in this session, since the ids of the in-memory tasks then no longer match
+         * the ids a load of the rewritten files assigns.
+         *
+         * @return True if the index was written, skipped or persistence is disabled, false on error.
+         */
+        bool saveIndex() {
+            if (!persistentIndex || !loaded) {
+                return true;
+            }
+            WriteScope scope(*this);
+            bool written = flushChanges() && flush();
+            waitForWrites();
+            if (!written || !rowsMatchFiles) {
+                return written;
+            }
+            if (!dateIndex.save(indexFilePath, dataSignature())) {
+                std::cerr << "Error: Unable to write index file: " << indexFilePath << "\n";
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns all tasks of a category.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @return A reference to the in-memory task table.
+         */
+        template <typename T>
+        const TaskTable<T>& getTasks() const {
+            return std::get<TaskTable<T>>(tasks);
+        }
+
+        /**
+         * @brief Returns the tasks of all categories scheduled for the given date.
+         *
+         * @param date The date to look for.
+         * @return References to the matching tasks, ordered by category and file order.
+         */
+        const std::vector<TaskRef>& findTasksForDate(Date date) const {
+            return dateIndex.find(date);
+        }
+
+        /**
+         * @brief Returns the tasks of all categories scheduled within a date range.
+         *
+         * @param first The first day of the range.
+         * @param last The last day of the range (inclusive).
+         * @return References to the matching tasks, ordered by date, category and file order.
+         */
+        std::vector<TaskRef> findTasksBetween(Date first, Date last) const {
+            return dateIndex.findRange(first, last);
+        }
+
+        /**
+         * @brief Returns the tasks of a category scheduled for the given date.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param date The date to look for.
+         * @return A `std::vector<T>` containing the matching tasks in file order.
+         */
+        template <typename T>
+        std::vector<T> getTasksForDate(Date date) const {
+            return collect<T>(dateIndex.find(date));
+        }
+
+        /**
+         * @brief Returns the tasks of a category scheduled within a date range.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param first The first day of the range.
+         * @param last The last day of the range (inclusive).
+         * @return A `std::vector<T>` containing the matching tasks ordered by date.
+         */
+        template <typename T>
+        std::vector<T> getTasksBetween(Date first, Date last) const {
+            return collect<T>(dateIndex.findRange(first, last));
+        }
+
+        /**
+         * @brief Builds the agenda unless it is already built.
+         *
+         * From then on the agenda is kept up to date, so `getAgenda()` only walks its first
+         * entries.
+         */
+        void buildAgenda() {
+            if (!agendaBuilt) {
+                buildAgenda<StudyTask>();
+                buildAgenda<LifeTask>();
+                buildAgenda<WorkTask>();
+                agendaBuilt = true;
+            }
+        }
+
+        /**
+         * @brief Returns the most urgent tasks of all categories.
+         *
+         * Tasks are ordered by deadline, then priority (highest first), then when-to-do date.
+         * `buildAgenda()` must have been called first.
+         *
+         * @param count The maximum number of tasks to return.
+         * @return Up to `count` agenda entries, most urgent first.
+         */
+        std::vector<Agenda::Entry> getAgenda(size_t count) const {
+            return agenda.top(count);
+        }
+
+        /**
+         * @brief Builds the search index unless it is already built.
+         *
+         * From then on the index is kept up to date, like the agenda, so `search()` never has
+         * to look at the tasks themselves.
+         */
+        void buildSearchIndex() {
+            if (!searchBuilt) {
+                buildSearchIndex<StudyTask>();
+                buildSearchIndex<LifeTask>();
+                buildSearchIndex<WorkTask>();
+                searchBuilt = true;
+            }
+        }
+
+        /**
+         * @brief Finds the tasks whose description, subject or assignee contain every query word.
+         *
+         * Words are matched case-insensitively; a word followed by `*` matches every word
+         * starting with it. `buildSearchIndex()` must have been called first.
+         *
+         * @param query The words to look for, e.g. "math home*".
+         * @return References to the matching tasks, ordered by category and file order.
+         */
+        std::vector<TaskRef> search(std::string_view query) const {
+            std::vector<TaskRef> result;
+            for (TaskCategory category : {TaskCategory::Study, TaskCategory::Life, TaskCategory::Work}) {
+                for (TaskId id : searchIndexes[indexOf(category)].find(query)) {
+                    result.push_back(TaskRef{category, id});
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Adds a task to memory and appends it to its category file.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param task The task to add.
+         * @param durability How far the record must be written before this returns. `None`
+         *        lets the appender batch it with the following records. With asynchronous
+         *        writes it applies to the I/O thread.
+         * @return True if the task was accepted by the appender, false on a write error.
+         */
+        template <typename T>
+        bool addTask(const T& task, Durability durability = Durability::Flush) {
+            WriteScope scope(*this);
+            std::string record = task.toFileString();
+            T stored = normalize(task, record);
+
+            TaskId id = tasksOf<T>().add(stored);
+            dateIndex.add(stored.getWhenToDo(), TaskRef{T::CATEGORY, id});
+            if (agendaBuilt) {
+                agenda.add(agendaEntry<T>(id));
+            }
+            if (searchBuilt) {
+                addWords<T>(id);
+            }
+            if (durability == Durability::None && !bufferedAppends) {
+                bufferedAppends = true;
+                oldestBufferedAppend = std::chrono::steady_clock::now();
+            }
+            return persist([this, record = std::move(record), durability] {
+                return appenderOf(T::CATEGORY).append(record, durability);
+            });
+        }
+
+        /**
+         * @brief Applies the changes made to a copy of a task through its setters.
+         *
+         * A task obtained from `getTasks<T>().get(id)` starts out clean; every setter marks it as
+         * dirty. Clean tasks are ignored. The change is visible to all queries at once, but
+         * nothing is written until `flushChanges()`, so editing a task several times costs one
+         * journal entry.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param id The id of the task.
+         * @param task The changed task.
+         * @return True if the task exists, false otherwise.
+         */
+        template <typename T>
+        bool updateTask(TaskId id, const T& task) {
+            TaskTable<T>& table = tasksOf<T>();
+            if (!table.contains(id)) {
+                return false;
+            }
+            if (!task.isDirty()) {
+                return true;
+            }
+
+            std::string record = task.toFileString();
+            T stored = normalize(task, record);
+            if (!table.isDirty(id)) {
+                // The entry must match the record as the journal last left it, so keep the
+                // record from before the first unsaved change.
+                pendingUpdates.push_back(PendingUpdate{TaskRef{T::CATEGORY, id}, table.get(id).toFileString()});
+            }
+
+            replaceTask(id, stored, true);
+            table.markDirty(id);
+            return true;
+        }
+
+        /**
+         * @brief Writes the tasks changed by `updateTask` to the journal.
+         *
+         * Only the dirty tasks are written, as one batch of `Update` entries with a single sync;
+         * the category files are left alone until the next compaction. Edits of tasks another
+         * session has changed in the meantime are discarded.
+         *
+         * @return True if every change is durable, false otherwise.
+         */
+        bool flushChanges() {
+            if (pendingUpdates.empty()) {
+                return true;
+            }
+            WriteScope scope(*this);
+            if (pendingUpdates.empty()) {
+                return true;
+            }
+
+            std::vector<JournalEntry> entries;
+            entries.reserve(pendingUpdates.size());
+            for (const PendingUpdate& update : pendingUpdates) {
+                switch (update.task.category) {
+                    case TaskCategory::Study:
+                        addUpdateEntry<StudyTask>(update, entries);
+                        break;
+                    case TaskCategory::Life:
+                        addUpdateEntry<LifeTask>(update, entries);
+                        break;
+                    case TaskCategory::Work:
+                        addUpdateEntry<WorkTask>(update, entries);
+                        break;
+                }
+            }
+
+            clearPendingUpdates();
+            // The records must be in the files before the journal refers to their lines.
+            return persist([this, entries = std::move(entries)] {
+                return flushAppenders(Durability::Flush) && journal.append(entries);
+            });
+        }
+
+        /**
+         * @brief Returns the number of tasks changed by `updateTask` but not yet written.
+         *
+         * @return The number of dirty tasks.
+         */
+        size_t pendingChanges() const {
+            return pendingUpdates.size();
+        }
+
+        /**
+         * @brief Writes all tasks still buffered by the appenders.
+         *
+         * @param durability `Fsync` additionally syncs the category files to disk.
+         * @return True if every appender was flushed, false otherwise.
+         */
+        bool flush(Durability durability = Durability::Flush) {
+            WriteScope scope(*this);
+            bufferedAppends = false;
+            return persist([this, durability] {
+                return flushAppenders(durability);
+            });
+        }
+
+        /**
+         * @brief Checks whether tasks added with `Durability::None` have waited too long.
+         *
+         * @return True if such a task has been buffered for `TaskAppender::DEFAULT_FLUSH_INTERVAL`
+         *         or longer without a `flush()` since.
+         */
+        bool isFlushDue() const {
+            return bufferedAppends && std::chrono::steady_clock::now() - oldestBufferedAppend
+                >= TaskAppender::DEFAULT_FLUSH_INTERVAL;
+        }
+
+        /**
+         * @brief Writes the buffered tasks once `isFlushDue()`.
+         *
+         * The appenders only look at the age of their buffer when a task is appended, so a
+         * task added last could wait indefinitely; this is meant to be called periodically
+         * (`TaskEngine` does so from a timer thread). Until the flush, the buffered tasks also
+         * keep the write lock of the task files.
+         *
+         * @return True if nothing was due or the tasks were written, false on a write error.
+         */
+        bool flushIfDue() {
+            return !isFlushDue() || flush();
+        }
+
+        /**
+         * @brief Changes the buffer size at which the appenders write pending tasks.
+         *
+         * @param bytes The new threshold in bytes.
+         */
+        void setAppendBufferSize(size_t bytes) {
+            waitForWrites();
+            studyAppender.setFlushBytes(bytes);
+            lifeAppender.setFlushBytes(bytes);
+            workAppender.setFlushBytes(bytes);
+        }
+
+        /**
+         * @brief Removes a task from memory and records the removal in the journal.
+         *
+         * Only one small journal entry is written; the category file itself is rewritten by the
+         * next compaction.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param id The id of the task.
+         * @return True if the task existed and the removal is durable, false otherwise.
+         */
+        template <typename T>
+        bool removeTask(TaskId id) {
+            WriteScope scope(*this);
+            TaskTable<T>& table = tasksOf<T>();
+            if (!table.contains(id)) {
+                return false;
+            }
+            // Later entries carry the fingerprint of the changed record, which must be logged first.
+            if (!flushChanges()) {
+                return false;
+            }
+
+            JournalEntry entry{JournalEntry::Type::Remove, T::CATEGORY, table.getLine(id),
+                TaskJournal::fingerprint(table.get(id).toFileString()), Date(), std::string()};
+
+            dateIndex.remove(table.getWhenToDo(id), TaskRef{T::CATEGORY, id});
+            if (agendaBuilt) {
+                agenda.remove(agendaEntry<T>(id));
+            }
+            if (searchBuilt) {
+                searchIndexes[indexOf(T::CATEGORY)].remove(id);
+            }
+            table.remove(id);
+
+            // The record must be in the file before the journal refers to its line.
+            return persist([this, entry = std::move(entry)] {
+                return appenderOf(T::CATEGORY).flush() && journal.append(entry);
+            });
+        }
+
+        /**
+         * @brief Folds the journal into the task files.
+         *
+         * Unsaved changes are written to the journal first; then every category file is
+         * rewritten with its live tasks and the journal is emptied. While other sessions are
+         * open, or while a previous compaction is still being written, the compaction is
+         * deferred, since the other sessions still refer to the lines of the current files.
+         *
+         * With asynchronous writes only the new content of the files is produced by the caller;
+         * writing and renaming the files and emptying the journal run on the I/O thread after
+         * the writes queued before, and a failure is counted for `takeWriteFailures()` and makes
+         * the next write reload the files.
+         *
+         * @return True if all files were written (or queued), or the compaction was deferred,
+         *         false otherwise.
+         */
+        bool compact() {
+            WriteScope scope(*this);
+            if (!flushChanges()) {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (compacting) {
+                    return true;
+                }
+            }
+            if (!sessionLock.tryLockExclusive()) {
+                sessionLock.lockShared();
+                return true;
+            }
+            if (io) {
+                return compactInBackground();
+            }
+            bool saved = rewriteCategory<StudyTask>()
+                & rewriteCategory<LifeTask>()
+                & rewriteCategory<WorkTask>();
+            sessionLock.lockShared();
+
+            // Keep the journal if a file could not be written, its entries are still needed.
+            return saved && journal.clear();
+        }
+
+        /**
+         * @brief Checks whether the journal has grown to `COMPACTION_THRESHOLD` entries.
+         *
+         * @return True if `compactIfDue()` would compact, false otherwise.
+         */
+        bool isCompactionDue() {
+            // The journal belongs to the I/O thread until it has finished.
+            std::lock_guard<std::mutex> lock(stateMutex);
+            return outstandingWrites == 0 && journal.size() >= COMPACTION_THRESHOLD;
+        }
+
+        /**
+         * @brief Compacts the journal once `isCompactionDue()`.
+         *
+         * Changes never compact on their own, so that each of them only costs a journal append;
+         * this is the separate step that folds the journal into the files, meant to be called
+         * periodically or when the application is idle (`TaskEngine` does so from its
+         * background thread).
+         *
+         * @return True if nothing was due or `compact()` succeeded, false otherwise.
+         */
+        bool compactIfDue() {
+            return !isCompactionDue() || compact();
+        }
+
+        /**
+         * @brief Rewrites a category file from its binary snapshot and reloads all tasks.
+         *
+         * The journal is folded into all files first, like `compact()` does, since its entries
+         * refer to lines of the current files. Unlike a compaction this is not deferred: it
+         * fails while other sessions are open, as they still read the current files.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param snapshotPath The path of the snapshot.
+         * @return True if the file was rewritten, false otherwise.
+         */
+        template <typename T>
+        bool restoreSnapshot(const std::string& snapshotPath) {
+            ensureLoaded();
+            WriteScope scope(*this);
+            waitForWrites();
+            if (!sessionLock.tryLockExclusive()) {
+                sessionLock.lockShared();
+                std::cerr << "Error: Other TaskManager sessions are open; close them before rewriting "
+                          << T::FILE_PATH << ".\n";
+                return false;
+            }
+            bool saved = rewriteCategory<StudyTask>()
+                & rewriteCategory<LifeTask>()
+                & rewriteCategory<WorkTask>();
+            if (saved) {
+                clearPendingUpdates();
+                saved = journal.clear() && TaskSnapshot::exportText<T>(snapshotPath, T::FILE_PATH);
+            }
+            loadAll();
+            sessionLock.lockShared();
+            return saved;
+        }
+
+        /**
+         * @brief Moves every task scheduled for one day to another day.
+         *
+         * The tasks are found through the date index and the changes of all three categories are
+         * recorded in the journal as one batch with a single sync, so the cost depends on the
+         * number of rescheduled tasks rather than on the size of the task files.
+         *
+         * @param today The current date.
+         * @param nextDay The new date.
+         * @param moved Receives the number of rescheduled tasks.
+         * @return True if the changes were recorded in the journal (or queued for the I/O
+         *         thread), false on a write error.
+         */
+        bool rescheduleTasks(Date today, Date nextDay, size_t& moved) {
+            WriteScope scope(*this);
+            moved = 0;
+            if (!flushChanges()) {
+                return false;
+            }
+            // Copy the bucket, it is modified while the tasks are moved.
+            std::vector<TaskRef> due = dateIndex.find(today);
+            std::vector<JournalEntry> entries;
+            entries.reserve(due.size());
+
+            for (const TaskRef& task : due) {
+                switch (task.category) {
+                    case TaskCategory::Study:
+                        entries.push_back(reschedule<StudyTask>(task.id, nextDay));
+                        break;
+                    case TaskCategory::Life:
+                        entries.push_back(reschedule<LifeTask>(task.id, nextDay));
+                        break;
+                    case TaskCategory::Work:
+                        entries.push_back(reschedule<WorkTask>(task.id, nextDay));
+                        break;
+                }
+                dateIndex.move(task, today, nextDay);
+            }
+
+            moved = due.size();
+            if (entries.empty()) {
+                return true;
+            }
+            return persist([this, entries = std::move(entries)] {
+                return flushAppenders(Durability::Flush) && journal.append(entries);
+            });
+        }
+
+        /**
+         * @brief Returns how long the initial load of the task files took.
+         *
+         * @return The load time in milliseconds.
+         */
+        double getLoadTimeMs() const {
+            return loadTimeMs;
+        }
+
+        /**
+         * @brief Checks whether the last load took the date index from the saved index file.
+         *
+         * @return True if the saved index was reused, false if the index was built.
+         */
+        bool isIndexReused() const {
+            return indexReused;
+        }
+
+        /**
+         * @brief Returns how many file reloads were served from memory instead.
+         *
+         * @return The number of avoided reloads.
+         */
+        size_t getAvoidedReloads() const {
+            return avoidedReloads;
+        }
+
+    private:
+        /** @brief The persistence layer used to read and write the task files. */
+        TaskStorage storage;
+
+        /** @brief The in-memory task tables, one per category. */
+        std::tuple<TaskTable<StudyTask>, TaskTable<LifeTask>, TaskTable<WorkTask>> tasks;
+
+        /** @brief Buffered writer for new study tasks. */
+        TaskAppender studyAppender{StudyTask::FILE_PATH};
+
+        /** @brief Buffered writer for new life tasks. */
+        TaskAppender lifeAppender{LifeTask::FILE_PATH};
+
+        /** @brief Buffered writer for new work tasks. */
+        TaskAppender workAppender{WorkTask::FILE_PATH};
+
+        /** @brief Append-only log of changes not yet folded into the task files. */
+        TaskJournal journal;
+
+        /** @brief Held exclusively while this session writes to the files. */
+        FileLock writeLock{WRITE_LOCK_PATH};
+
+        /** @brief Held shared while this session is open, exclusively while it compacts. */
+        FileLock sessionLock{SESSION_LOCK_PATH};
+
+        /** @brief Number of `WriteScope`s currently open. */
+        size_t writeDepth = 0;
+
+        /** @brief Number of `WriteReservation`s currently held. */
+        size_t reservations = 0;
+
+        /** @brief Whether the write lock was taken but the writes of other sessions are unread. */
+        bool needsCatchUp = false;
+
+        /** @brief Guards the write lock, `writeDepth` and the counters shared with the I/O thread. */
+        std::mutex stateMutex;
+
+        /** @brief Signalled whenever the I/O thread finishes a write. */
+        std::condition_variable writesDone;
+
+        /** @brief Number of writes queued for the I/O thread and not finished yet. */
+        size_t outstandingWrites = 0;
+
+        /** @brief Number of failed background writes not yet taken by `takeWriteFailures()`. */
+        size_t writeFailures = 0;
+
+        /** @brief Whether a compaction is queued for or running on the I/O thread. */
+        bool compacting = false;
+
+        /** @brief Whether a compaction on the I/O thread failed, so the files must be reloaded. */
+        bool reloadNeeded = false;
+
+        /** @brief Length of each category file as far as it is in memory, by category. */
+        std::array<size_t, TASK_CATEGORY_COUNT> knownBytes{};
+
+        /**
+         * @struct PendingUpdate
+         * @brief A task changed by `updateTask` whose change is not in the journal yet.
+         */
+        struct PendingUpdate {
+            /** @brief The changed task. */
+            TaskRef task;
+
+            /** @brief The task's record before its first unsaved change. */
+            std::string record;
+        };
+
+        /**
+         * @class WriteScope
+         * @brief Holds the write lock of the repository while a change is written.
+         *
+         * Scopes nest; the outermost one takes the lock and catches up with other sessions. The
+         * lock is kept after the scope ends while the appenders still buffer records, since
+         * their line numbers are already assigned.
+         */
+        class WriteScope {
+        public:
+            explicit WriteScope(TaskRepository& repository)
+                : repository(repository) {
+                repository.beginWrite();
+            }
+
+            WriteScope(const WriteScope&) = delete;
+            WriteScope& operator=(const WriteScope&) = delete;
+
+            ~WriteScope() {
+                repository.endWrite();
+            }
+
+        private:
+            TaskRepository& repository;
+        };
+
+        /** @brief The dirty tasks, in the order they were first changed. */
+        std::vector<PendingUpdate> pendingUpdates;
+
+        /** @brief Index of all tasks by when-to-do date. */
+        DateIndex dateIndex;
+
+        /** @brief Tasks of all categories ordered by deadline and priority. */
+        Agenda agenda;
+
+        /** @brief Whether `agenda` has been built and is being kept up to date. */
+        bool agendaBuilt = false;
+
+        /** @brief The words of the tasks, by category. */
+        std::array<SearchIndex, TASK_CATEGORY_COUNT> searchIndexes;
+
+        /** @brief Whether `searchIndexes` have been built and are being kept up to date. */
+        bool searchBuilt = false;
+
+        /** @brief Whether a task was added with `Durability::None` since the last `flush()`. */
+        bool bufferedAppends = false;
+
+        /** @brief When the first of those tasks was added. */
+        std::chrono::steady_clock::time_point oldestBufferedAppend;
+
+        /** @brief Whether the date index is saved to and loaded from `indexFilePath`. */
+        bool persistentIndex = false;
+
+        /** @brief Whether the last load reused the saved date index. */
+        bool indexReused = false;
+
+        /** @brief Whether every row of the tables is a record of the current files, in file order. */
+        bool rowsMatchFiles = false;
+
+        /** @brief The path of the date index file. */
+        std::string indexFilePath = INDEX_FILE_PATH;
+
+        /** @brief Whether the task files are also kept as binary `TaskSnapshot`s. */
+        bool snapshots = false;
+
+        /** @brief Whether the task files have already been read. */
+        bool loaded = false;
+
+        /** @brief The I/O thread of asynchronous writes; destroyed first, after its last write. */
+        std::unique_ptr<ThreadPool> io;
+
+        /** @brief Duration of the initial load in milliseconds. */
+        double loadTimeMs = 0.0;
+
+        /** @brief Number of `ensureLoaded()` calls that did not touch the disk. */
+        size_t avoidedReloads = 0;
+
+        template <typename T>
+        TaskTable<T>& tasksOf() {
+            return std::get<TaskTable<T>>(tasks);
+        }
+
+        TaskAppender& appenderOf(TaskCategory category) {
+            switch (category) {
+                case TaskCategory::Study:
+                    return studyAppender;
+                case TaskCategory::Life:
+                    return lifeAppender;
+                default:
+                    return workAppender;
+            }
+        }
+
+        static constexpr size_t indexOf(TaskCategory category) {
+            return static_cast<size_t>(category);
+        }
+
+        size_t pendingBytes() const {
+            return studyAppender.pendingBytes() + lifeAppender.pendingBytes() + workAppender.pendingBytes();
+        }
+
+        void beginWrite() {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            if (writeDepth++ > 0) {
+                return;
+            }
+            lockFiles(lock);
+            // The lock is only taken while the I/O thread is idle, so catching up cannot race it.
+            if (needsCatchUp) {
+                needsCatchUp = false;
+                if (loaded) {
+                    catchUp();
+                }
+            }
+        }
+
+        void endWrite() {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            --writeDepth;
+            releaseWriteLockIfIdle();
+        }
+
+        void reserveWrite() {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            ++reservations;
+            lockFiles(lock);
+        }
+
+        void endReservation() {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            --reservations;
+            releaseWriteLockIfIdle();
+        }
+
+        void lockFiles(std::unique_lock<std::mutex>& lock) {
+            // Another session may hold the lock for a long time, so this polls with `stateMutex`
+            // released in between instead of waiting in `flock` and blocking the I/O thread.
+            while (writeLock.getMode() != FileLock::Mode::Exclusive) {
+                if (writeLock.tryLockExclusive()) {
+                    needsCatchUp = true;
+                    return;
+                }
+                if (errno != EWOULDBLOCK) {
+                    // The lock file cannot be used at all; write without it, as before.
+                    return;
+                }
+                lock.unlock();
+                std::this_thread::sleep_for(WRITE_LOCK_RETRY);
+                lock.lock();
+            }
+        }
+
+        void releaseWriteLockIfIdle() {
+            if (writeDepth > 0 || reservations > 0 || outstandingWrites > 0 || pendingBytes() > 0) {
+                return;
+            }
+            // Everything up to the end of the files was either read or written by this session,
+            // unless the lock was given back before catching up.
+            if (!needsCatchUp) {
+                knownBytes[indexOf(TaskCategory::Study)] = fileSize(StudyTask::FILE_PATH);
+                knownBytes[indexOf(TaskCategory::Life)] = fileSize(LifeTask::FILE_PATH);
+                knownBytes[indexOf(TaskCategory::Work)] = fileSize(WorkTask::FILE_PATH);
+            }
+            needsCatchUp = false;
+            writeLock.unlock();
+        }
+
+        template <typename Write>
+        bool persist(Write&& write) {
+            if (!io) {
+                return write();
+            }
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                ++outstandingWrites;
+            }
+            io->submit([this, write = std::forward<Write>(write)]() mutable {
+                bool written = write();
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!written) {
+                    ++writeFailures;
+                }
+                --outstandingWrites;
+                releaseWriteLockIfIdle();
+                writesDone.notify_all();
+            });
+            return true;
+        }
+
+        bool flushAppenders(Durability durability) {
+            return studyAppender.flush(durability)
+                & lifeAppender.flush(durability)
+                & workAppender.flush(durability);
+        }
+
+        static size_t fileSize(const std::string& filePath) {
+            int64_t size = DateIndex::FileSignature::of(filePath).size;
+            return size > 0 ? static_cast<size_t>(size) : 0;
+        }
+
+        void loadAll() {
+            DateIndex::Signature before = dataSignature();
+            // The journal is read first: the records an entry refers to were written before the
+            // entry, so they are in the category files read afterwards.
+            std::vector<JournalEntry> entries;
+            journal.replay([&entries](const JournalEntry& entry) {
+                entries.push_back(entry);
+            });
+            {
+                // All chunks of all three files are queued before waiting for any of them.
+                ThreadPool pool;
+                TaskStorage::PendingLoad<StudyTask> study;
+                TaskStorage::PendingLoad<LifeTask> life;
+                TaskStorage::PendingLoad<WorkTask> work;
+                bool parseStudy = startCategory(pool, study);
+                bool parseLife = startCategory(pool, life);
+                bool parseWork = startCategory(pool, work);
+                finishCategory(study, parseStudy);
+                finishCategory(life, parseLife);
+                finishCategory(work, parseWork);
+            }
+            applyEntries(entries, false);
+            // Replayed updates are already on disk.
+            clearPendingUpdates();
+
+            dateIndex.clear();
+            agenda.clear();
+            for (SearchIndex& index : searchIndexes) {
+                index.clear();
+            }
+            // Queries rely on the agenda and the index once they exist, so they are rebuilt
+            // right away.
+            if (agendaBuilt) {
+                agendaBuilt = false;
+                buildAgenda();
+            }
+            if (searchBuilt) {
+                searchBuilt = false;
+                buildSearchIndex();
+            }
+            // A saved index only fits if no other session wrote anything while the files were read.
+            indexReused = persistentIndex && before == dataSignature() && dateIndex.load(indexFilePath, before);
+            if (!indexReused) {
+                buildIndex<StudyTask>();
+                buildIndex<LifeTask>();
+                buildIndex<WorkTask>();
+            }
+            rowsMatchFiles = true;
+        }
+
+        void catchUp() {
+            std::vector<JournalEntry> entries;
+            bool current = !reloadNeeded && journal.catchUp([&entries](const JournalEntry& entry) {
+                entries.push_back(entry);
+            });
+            current = current && catchUpCategory<StudyTask>()
+                && catchUpCategory<LifeTask>()
+                && catchUpCategory<WorkTask>();
+
+            if (!current) {
+                // Only happens if a background compaction failed halfway or the files were
+                // changed without taking the session lock.
+                std::cerr << (reloadNeeded ? "Error: The task files could not be compacted, reloading them"
+                                           : "Error: The task files were replaced by another process, reloading them")
+                          << (pendingUpdates.empty() ? "" : " and discarding unsaved changes") << ".\n";
+                reloadNeeded = false;
+                studyAppender.reset();
+                lifeAppender.reset();
+                workAppender.reset();
+                loadAll();
+                return;
+            }
+            applyEntries(entries, true);
+        }
+
+        template <typename T>
+        bool catchUpCategory() {
+            // Most writes find nothing new; a stat is much cheaper than mapping the file.
+            if (fileSize(T::FILE_PATH) == knownBytes[indexOf(T::CATEGORY)]) {
+                return true;
+            }
+            TaskTable<T>& table = tasksOf<T>();
+            size_t first = table.capacity();
+            size_t rejected = table.getRejectedLines().size();
+            if (!storage.loadAppended(T::FILE_PATH, table, knownBytes[indexOf(T::CATEGORY)])) {
+                return false;
+            }
+            reportRejectedLines<T>(rejected);
+            for (size_t row = first; row < table.capacity(); ++row) {
+                TaskId id = static_cast<TaskId>(row);
+                if (table.contains(id)) {
+                    dateIndex.add(table.getWhenToDo(id), TaskRef{T::CATEGORY, id});
+                    if (agendaBuilt) {
+                        agenda.add(agendaEntry<T>(id));
+                    }
+                    if (searchBuilt) {
+                        addWords<T>(id);
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <typename T>
+        bool startCategory(ThreadPool& pool, TaskStorage::PendingLoad<T>& load) {
+            TaskTable<T>& table = tasksOf<T>();
+            table.clear();
+            knownBytes[indexOf(T::CATEGORY)] = 0;
+            if (snapshots) {
+                DateIndex::FileSignature source = DateIndex::FileSignature::of(T::FILE_PATH);
+                if (TaskSnapshot::load(TaskSnapshot::pathFor(T::FILE_PATH), table, &source)) {
+                    knownBytes[indexOf(T::CATEGORY)] = static_cast<size_t>(source.size);
+                    return false;
+                }
+            }
+            load = storage.startLoad<T>(T::FILE_PATH, pool);
+            return true;
+        }
+
+        template <typename T>
+        void finishCategory(TaskStorage::PendingLoad<T>& load, bool started) {
+            if (!started) {
+                return;
+            }
+            if (!storage.finishLoad(load, tasksOf<T>())) {
+                std::cerr << "Error: Could not open file: " << T::FILE_PATH << "\n";
+                return;
+            }
+            knownBytes[indexOf(T::CATEGORY)] = load.size();
+            reportRejectedLines<T>(0);
+
+            // A file that grew while it was parsed must not be described by the snapshot.
+            DateIndex::FileSignature source = DateIndex::FileSignature::of(T::FILE_PATH);
+            if (snapshots && source.size == static_cast<int64_t>(load.size())) {
+                saveSnapshot<T>(source);
+            }
+        }
+
+        template <typename T>
+        void reportRejectedLines(size_t first) const {
+            const auto& rejected = getTasks<T>().getRejectedLines();
+            size_t records = 0;
+            for (size_t i = first; i < rejected.size(); ++i) {
+                if (rejected[i].text.find_first_not_of(" \t\r") != std::string_view::npos) {
+                    ++records;
+                }
+            }
+            if (records > 0) {
+                std::cerr << "Error: " << records << " line(s) of " << T::FILE_PATH
+                          << " are not valid tasks and were skipped; they are kept in the file.\n";
+            }
+        }
+
+        template <typename T>
+        bool saveSnapshot(const DateIndex::FileSignature& source) const {
+            return TaskSnapshot::save(TaskSnapshot::pathFor(T::FILE_PATH), getTasks<T>(), source);
+        }
+
+        template <typename T>
+        void buildIndex() {
+            const TaskTable<T>& table = getTasks<T>();
+            for (TaskId id : table.liveIds()) {
+                dateIndex.add(table.getWhenToDo(id), TaskRef{T::CATEGORY, id});
+            }
+        }
+
+        template <typename T>
+        void buildAgenda() {
+            const TaskTable<T>& table = getTasks<T>();
+            for (TaskId id : table.liveIds()) {
+                agenda.add(agendaEntry<T>(id));
+            }
+        }
+
+        template <typename T>
+        void buildSearchIndex() {
+            const TaskTable<T>& table = getTasks<T>();
+            for (TaskId id : table.liveIds()) {
+                addWords<T>(id);
+            }
+        }
+
+        template <typename T>
+        void addWords(TaskId id) {
+            const TaskTable<T>& table = getTasks<T>();
+            SearchIndex& index = searchIndexes[indexOf(T::CATEGORY)];
+            index.add(id, table.getDescription(id));
+            index.add(id, table.getLabel(id));
+        }
+
+        template <typename T>
+        std::vector<std::string> wordsOf(TaskId id) const {
+            const TaskTable<T>& table = getTasks<T>();
+            return SearchIndex::wordsOf({table.getDescription(id), table.getLabel(id)});
+        }
+
+        template <typename T>
+        Agenda::Entry agendaEntry(TaskId id) const {
+            const TaskTable<T>& table = getTasks<T>();
+            return Agenda::Entry{table.getDeadline(id), table.getPriority(id), table.getWhenToDo(id),
+                TaskRef{T::CATEGORY, id}};
+        }
+
+        template <typename T>
+        std::vector<T> collect(const std::vector<TaskRef>& refs) const {
+            const TaskTable<T>& table = getTasks<T>();
+            std::vector<T> result;
+            for (const TaskRef& task : refs) {
+                if (task.category == T::CATEGORY) {
+                    result.push_back(table.get(task.id));
+                }
+            }
+            return result;
+        }
+
+        bool compactInBackground() {
+            // Lines are renumbered now, so changes made while the files are written already
+            // refer to the new files; they are appended only after the rewrite.
+            std::string study = formatCategory<StudyTask>();
+            std::string life = formatCategory<LifeTask>();
+            std::string work = formatCategory<WorkTask>();
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                compacting = true;
+            }
+            return persist([this, study = std::move(study), life = std::move(life),
+                            work = std::move(work)] {
+                bool saved = replaceCategory<StudyTask>(study)
+                    & replaceCategory<LifeTask>(life)
+                    & replaceCategory<WorkTask>(work);
+                sessionLock.lockShared();
+                saved = saved && journal.clear();
+
+                std::lock_guard<std::mutex> lock(stateMutex);
+                compacting = false;
+                reloadNeeded = reloadNeeded || !saved;
+                return saved;
+            });
+        }
+
+        template <typename T>
+        std::string formatCategory() {
+            TaskTable<T>& table = tasksOf<T>();
+            std::ostringstream text;
+            TaskStorage::formatTasks(text, table);
+            table.renumberLines();
+            rowsMatchFiles = false;
+            return text.str();
+        }
+
+        template <typename T>
+        bool replaceCategory(const std::string& text) {
+            // The new file contains every buffered task, so the buffer is dropped.
+            appenderOf(T::CATEGORY).reset();
+            // The snapshot no longer matches the file and is replaced on the next load.
+            return TaskStorage::saveText(T::FILE_PATH, text);
+        }
+
+        template <typename T>
+        bool rewriteCategory() {
+            TaskTable<T>& table = tasksOf<T>();
+            // The rewritten file contains every buffered task, so the buffer is dropped.
+            appenderOf(T::CATEGORY).reset();
+            rowsMatchFiles = false;
+            if (!storage.saveTasks(T::FILE_PATH, table)) {
+                return false;
+            }
+            table.renumberLines();
+            DateIndex::FileSignature source = DateIndex::FileSignature::of(T::FILE_PATH);
+            knownBytes[indexOf(T::CATEGORY)] = fileSize(T::FILE_PATH);
+            if (snapshots) {
+                saveSnapshot<T>(source);
+            }
+            return true;
+        }
+
+        template <typename T>
+        static T normalize(const T& task, const std::string& record) {
+            // Keep the task exactly as a later load will read it back, so journal fingerprints match.
+            T stored = task;
+            if (!parseRecord(std::string_view(record).substr(0, record.size() - 1), stored)) {
+                stored = task;
+            }
+            return stored;
+        }
+
+        template <typename T>
+        static bool parseRecord(std::string_view record, T& task) {
+            RecordFields fields;
+            RecordReader::splitLine(record, fields);
+            return task.loadFromFields(fields);
+        }
+
+        template <typename T>
+        void addUpdateEntry(const PendingUpdate& update, std::vector<JournalEntry>& entries) const {
+            const TaskTable<T>& table = getTasks<T>();
+            if (!table.contains(update.task.id)) {
+                return;
+            }
+            std::string record = table.get(update.task.id).toFileString();
+            record.pop_back();
+            entries.push_back(JournalEntry{JournalEntry::Type::Update, T::CATEGORY,
+                table.getLine(update.task.id), TaskJournal::fingerprint(update.record), Date(), std::move(record)});
+        }
+
+        void clearPendingUpdates() {
+            pendingUpdates.clear();
+            tasksOf<StudyTask>().clearDirty();
+            tasksOf<LifeTask>().clearDirty();
+            tasksOf<WorkTask>().clearDirty();
+        }
+
+        template <typename T>
+        JournalEntry reschedule(TaskId id, Date date) {
+            TaskTable<T>& table = tasksOf<T>();
+            JournalEntry entry{JournalEntry::Type::Reschedule, T::CATEGORY, table.getLine(id),
+                TaskJournal::fingerprint(table.get(id).toFileString()), date, std::string()};
+            if (agendaBuilt) {
+                agenda.reschedule(agendaEntry<T>(id), date);
+            }
+            table.setWhenToDo(id, date);
+            return entry;
+        }
+
+        void applyEntries(const std::vector<JournalEntry>& entries, bool indexed) {
+            for (const JournalEntry& entry : entries) {
+                switch (entry.category) {
+                    case TaskCategory::Study:
+                        applyEntry<StudyTask>(entry, indexed);
+                        break;
+                    case TaskCategory::Life:
+                        applyEntry<LifeTask>(entry, indexed);
+                        break;
+                    case TaskCategory::Work:
+                        applyEntry<WorkTask>(entry, indexed);
+                        break;
+                }
+            }
+        }
+
+        template <typename T>
+        void applyEntry(const JournalEntry& entry, bool indexed) {
+            TaskTable<T>& table = tasksOf<T>();
+            TaskId id;
+            if (!table.findByLine(entry.line, id)) {
+                return;
+            }
+            if (table.isDirty(id) && !discardUpdate<T>(id, entry.fingerprint, indexed)) {
+                return;
+            }
+            if (TaskJournal::fingerprint(table.get(id).toFileString()) != entry.fingerprint) {
+                return;
+            }
+
+            TaskRef task{T::CATEGORY, id};
+            switch (entry.type) {
+                case JournalEntry::Type::Remove:
+                    if (indexed) {
+                        dateIndex.remove(table.getWhenToDo(id), task);
+                        if (agendaBuilt) {
+                            agenda.remove(agendaEntry<T>(id));
+                        }
+                        if (searchBuilt) {
+                            searchIndexes[indexOf(T::CATEGORY)].remove(id);
+                        }
+                    }
+                    table.remove(id);
+                    break;
+                case JournalEntry::Type::Reschedule:
+                    if (indexed) {
+                        dateIndex.move(task, table.getWhenToDo(id), entry.date);
+                        if (agendaBuilt) {
+                            agenda.reschedule(agendaEntry<T>(id), entry.date);
+                        }
+                    }
+                    table.setWhenToDo(id, entry.date);
+                    break;
+                case JournalEntry::Type::Update: {
+                    T updated;
+                    if (parseRecord(entry.record, updated)) {
+                        replaceTask(id, updated, indexed);
+                    }
+                    break;
+                }
+            }
+        }
+
+        template <typename T>
+        bool discardUpdate(TaskId id, uint64_t fingerprint, bool indexed) {
+            // Another session changed the record this session's unsaved edit started from; the
+            // committed change wins, so the task is put back the way it is on disk.
+            auto pending = std::find_if(pendingUpdates.begin(), pendingUpdates.end(),
+                [id](const PendingUpdate& update) {
+                    return update.task.category == T::CATEGORY && update.task.id == id;
+                });
+            if (pending == pendingUpdates.end() || TaskJournal::fingerprint(pending->record) != fingerprint) {
+                return false;
+            }
+
+            T original;
+            if (parseRecord(std::string_view(pending->record).substr(0, pending->record.size() - 1), original)) {
+                replaceTask(id, original, indexed);
+            }
+            std::cerr << "Error: Task \"" << getTasks<T>().getDescription(id)
+                      << "\" was changed by another session, your unsaved edit was discarded.\n";
+            tasksOf<T>().markClean(id);
+            pendingUpdates.erase(pending);
+            return true;
+        }
+
+        template <typename T>
+        void replaceTask(TaskId id, const T& task, bool indexed) {
+            TaskTable<T>& table = tasksOf<T>();
+            if (indexed) {
+                dateIndex.move(TaskRef{T::CATEGORY, id}, table.getWhenToDo(id), task.getWhenToDo());
+                if (agendaBuilt) {
+                    agenda.remove(agendaEntry<T>(id));
+                }
+            }
+            // The arena may move when the new text is stored, so the old words are copied first.
+            std::vector<std::string> words;
+            if (indexed && searchBuilt) {
+                words = wordsOf<T>(id);
+            }
+            table.assign(id, task);
+            if (indexed && agendaBuilt) {
+                agenda.add(agendaEntry<T>(id));
+            }
+            if (indexed && searchBuilt) {
+                searchIndexes[indexOf(T::CATEGORY)].replace(id, words, wordsOf<T>(id));
+            }
+        }
+
+        DateIndex::Signature dataSignature() const {
+            return DateIndex::Signature{
+                DateIndex::FileSignature::of(StudyTask::FILE_PATH),
+                DateIndex::FileSignature::of(LifeTask::FILE_PATH),
+                DateIndex::FileSignature::of(WorkTask::FILE_PATH),
+                DateIndex::FileSignature::of(TaskJournal::FILE_PATH)
+            };
+        }
+    };
+}
+
+#endif
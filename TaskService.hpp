@@ -1,18 +1,49 @@
 #ifndef TASK_SERVICE_HPP
 #define TASK_SERVICE_HPP
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
 #include "StudyTask.hpp"
 #include "WorkTask.hpp"
 #include "LifeTask.hpp"
+#include "TaskEngine.hpp"
+#include "Clock.hpp"
+#include "Frame.hpp"
 using namespace am;
 
 namespace am {
     class TaskService {
     public:
 
+        /**
+         * @brief Default constructor for a service that follows the system clock.
+         *
+         * The task files are backed by binary snapshots, so a restart with unchanged files
+         * does not parse them again, and the date index is saved on exit and reused while the
+         * files are unchanged. Changes are written on a background I/O thread, so no menu action
+         * waits for the disk.
+         */
+        TaskService() {
+            engine.setSnapshots(true);
+            engine.setPersistentIndex(true);
+            engine.setAsyncWrites(true);
+        }
+
+        /**
+         * @brief Constructor for a service driven by a given clock.
+         *
+         * @param clock The clock used to decide which day is "today", e.g. a fixed clock.
+         */
+        explicit TaskService(const Clock& clock)
+            : clock(clock) {
+            engine.setSnapshots(true);
+            engine.setPersistentIndex(true);
+            engine.setAsyncWrites(true);
+        }
+
         /**
          * @brief Main loop of the To-Do List application.
          *
@@ -29,33 +60,46 @@ namespace am {
          * - **3**: Mark a task as completed.
          * - **4**: Reschedule unfinished tasks from today to the next day.
          * - **5**: Exit the application.
+         * - **6**: Show the agenda of the most urgent tasks.
+         * - **7**: Show the next page of today's tasks.
+         * - **8**: Search the tasks of all days by words of their texts.
          *
          * Depending on the user's choice, the function invokes corresponding helper
          * functions to perform the requested actions.
          *
          * - **Invalid Input Handling**: If the user enters an invalid choice, a message
          *   is displayed, and the menu is shown again.
-         * - **Exit**: Choosing option 5 exits the loop and terminates the application.
+         * - **Exit**: Choosing option 5 waits until every change is written, reports changes
+         *   that could not be saved and terminates the application.
+         *
+         * The task files are read once, on the first iteration. Every later redraw is served
+         * from the in-memory tasks of the `TaskEngine`, which can be shared with other threads.
+         * Today's tasks and the menu are formatted into one `Frame` and printed with a single write.
          *
          * @see loadAndDisplayTasksForToday()
          * @see addTaskForToday()
          * @see runTaskCreation()
          * @see markTaskAsDone()
          * @see rescheduleUnfinishedTasks()
+         * @see displayAgenda()
+         * @see searchTasks()
          */
         void runApplication() {
             int choice = 0;
 
             while (true) {
                 loadAndDisplayTasksForToday();
-                std::cout << "\nOptions:" << std::endl;
-                std::cout << "1 - Add task for today" << std::endl;
-                std::cout << "2 - Add task (custom date)" << std::endl;
-                std::cout << "3 - Mark task as done" << std::endl;
-                std::cout << "4 - Reschedule tasks from today to next day" << std::endl;
-                std::cout << "5 - Exit" << std::endl;
-
-                std::cout << "Choose an option: ";
+                frame.append("\nOptions:\n"
+                             "1 - Add task for today\n"
+                             "2 - Add task (custom date)\n"
+                             "3 - Mark task as done\n"
+                             "4 - Reschedule tasks from today to next day\n"
+                             "5 - Exit\n"
+                             "6 - Show agenda\n"
+                             "7 - Next page of today's tasks\n"
+                             "8 - Search tasks\n"
+                             "Choose an option: ");
+                frame.flush();
                 std::cin >> choice;
 
                 switch (choice) {
@@ -72,182 +116,304 @@ namespace am {
                         rescheduleUnfinishedTasks();
                         break;
                     case 5:
-                        std::cout << "Exiting application..." << std::endl;
+                        std::cout << "Exiting application...\n";
+                        engine.saveIndex();
+                        engine.waitForWrites();
+                        reportWriteFailures();
+                        frame.flush();
+                        engine.read([](const TaskRepository& repository) {
+                            std::cout << "Tasks loaded in " << repository.getLoadTimeMs() << " ms"
+                                      << (repository.isIndexReused() ? " (saved index reused), " : ", ")
+                                      << repository.getAvoidedReloads() << " reloads avoided.\n";
+                        });
                         return;
+                    case 6:
+                        displayAgenda();
+                        break;
+                    case 7:
+                        ++page;
+                        break;
+                    case 8:
+                        searchTasks();
+                        break;
                     default:
-                        std::cout << "Invalid option. Please choose between 1 and 4." << std::endl;
+                        std::cout << "Invalid option. Please choose between 1 and 8.\n";
                         break;
                 }
             }
         }
 
     private:
+        /** @brief Number of tasks shown by the agenda. */
+        static constexpr size_t AGENDA_SIZE = 10;
+
+        /** @brief Number of matches shown by a search. */
+        static constexpr size_t SEARCH_RESULTS = 20;
+
+        /** @brief Number of tasks of each category shown on one page of today's tasks. */
+        static constexpr size_t PAGE_SIZE = 20;
+
+        /** @brief Thread-safe store of all tasks, loaded once and kept for the whole session. */
+        TaskEngine engine;
+
+        /** @brief Calendar service that caches today's date until midnight. */
+        Clock clock;
+
+        /** @brief Buffer the screen is formatted into, reused for every redraw. */
+        Frame frame;
+
+        /** @brief The page of today's tasks currently shown, starting at 0. */
+        size_t page = 0;
 
         /**
-         * @brief Retrieves the current date in the format "DD.MM.YYYY".
+         * @brief Reads a date in "DD.MM.YYYY" format from the user.
          *
-         * This function gets the current date by using the system's local time and formats it
-         * into a string representation with the format "day.month.year" (e.g., "09.01.2025").
-         * The formatted date string is returned as a `std::string`.
+         * The user is asked again until a valid calendar date is entered.
          *
-         * @return A `std::string` containing the current date in the format "DD.MM.YYYY".
+         * @return The entered date.
+         */
+        Date readDate() {
+            std::string text;
+            Date date;
+            while (std::getline(std::cin, text) && !Date::parse(text, date)) {
+                std::cout << "Invalid date. Please use DD.MM.YYYY: ";
+            }
+            return date;
+        }
+
+        /**
+         * @brief Reads a priority ("low", "medium" or "high") from the user.
+         *
+         * The user is asked again until a known priority is entered; case is ignored.
          *
-         * @note The function uses the system's local time and relies on the `strftime` function
-         *       to format the date.
+         * @return The entered priority.
          */
-        std::string getTodayDate() {
-            time_t t = time(0);
-            tm* now = localtime(&t);
-            char buf[11];
-            strftime(buf, sizeof(buf), "%d.%m.%Y", now);
-            return std::string(buf);
+        Priority readPriority() {
+            std::string text;
+            Priority priority = Priority::Low;
+            while (std::getline(std::cin, text) && !parsePriority(text, priority)) {
+                std::cout << "Invalid priority. Please enter low, medium or high: ";
+            }
+            return priority;
+        }
+
+        /**
+         * @brief Reads a description, subject or assignee from the user.
+         *
+         * The user is asked again while the text contains a comma, which the task files cannot
+         * store.
+         *
+         * @return The entered text.
+         */
+        std::string readText() {
+            std::string text;
+            while (std::getline(std::cin, text) && !Task::isStorableText(text)) {
+                std::cout << "Commas cannot be stored in a task. Please enter it again: ";
+            }
+            return text;
         }
 
         /**
          * @brief Loads and displays tasks for today.
          *
-         * This function retrieves the current date and uses it to load and display tasks
-         * for today from three categories: Study, Life, and Work. It uses the `loadTasks` 
-         * function to load tasks from corresponding file paths for each category and 
-         * then displays them using the `displayTasks` function.
+         * This function retrieves the current date and uses it to display tasks for today
+         * from three categories: Study, Life, and Work. The task files are only read on the
+         * first call; afterwards the tasks are taken from the in-memory repository.
          *
          * The function performs the following actions:
-         * - Retrieves the current date using `getTodayDate()`.
-         * - Loads tasks for today from files specific to Study, Life, and Work categories.
-         * - Displays the loaded tasks for each category with the appropriate labels.
+         * - Retrieves the current date from the cached `Clock`.
+         * - Makes sure the tasks are loaded and picks up tasks written by other sessions.
+         * - Formats the current page of today's tasks for each category with the appropriate
+         *   labels into the frame. The frame is printed together with the menu.
          *
-         * @see getTodayDate()
-         * @see loadTasks()
+         * If the current page lies past the last task of every category, the first page is shown.
+         *
+         * @see Clock::today()
+         * @see TaskRepository::findTasksForDate()
          * @see displayTasks()
          */
         void loadAndDisplayTasksForToday() {
-            std::string today = getTodayDate();
-            std::cout << "\nTasks for today (" << today << "):\n";
-
-            std::vector<StudyTask> studyTasks = loadTasks<StudyTask>(StudyTask::FILE_PATH, today);
-            std::vector<LifeTask> lifeTasks = loadTasks<LifeTask>(LifeTask::FILE_PATH, today);
-            std::vector<WorkTask> workTasks = loadTasks<WorkTask>(WorkTask::FILE_PATH, today);
+            Date today = clock.today();
+            reportWriteFailures();
+            frame.append("\nTasks for today (").append(today).append("):\n");
+
+            engine.refresh();
+            engine.read([this, today](const TaskRepository& repository) {
+                const std::vector<TaskRef>& tasks = repository.findTasksForDate(today);
+                size_t counts[3] = {0, 0, 0};
+                for (const TaskRef& task : tasks) {
+                    ++counts[static_cast<size_t>(task.category)];
+                }
+                size_t longest = std::max({counts[0], counts[1], counts[2]});
+                if (page * PAGE_SIZE >= longest) {
+                    page = 0;
+                }
 
-            displayTasks("Study Tasks", studyTasks, 31);
-            displayTasks("Life Tasks", lifeTasks, 33);
-            displayTasks("Work Tasks", workTasks, 32);
+                displayTasks<StudyTask>(repository, "Study Tasks", tasks, 31);
+                displayTasks<LifeTask>(repository, "Life Tasks", tasks, 33);
+                displayTasks<WorkTask>(repository, "Work Tasks", tasks, 32);
+            });
         }
 
         /**
-         * @brief Loads tasks from a file for a specific date.
-         *
-         * This function loads tasks from the specified file for a given date. The tasks are filtered
-         * based on the provided date, and only those that are scheduled for today (as determined by
-         * `getTodayDate()`) are returned. It ensures that the template type `T` is a subclass of `Task`.
-         *
-         * The function performs the following steps:
-         * - Opens the specified file and reads each line.
-         * - For each line, attempts to load the task using the `loadFromStream` method.
-         * - Checks if the task is scheduled for today by comparing the date with `getTodayDate()`.
-         * - Returns a vector of tasks that are scheduled for today.
-         *
-         * @tparam T The type of task to load. It must derive from the `Task` class.
+         * @brief Formats a line about changes the I/O thread could not write, if there are any.
          *
-         * @param filePath The path to the file containing the task data.
-         * @param date The date for which tasks should be loaded.
+         * @see TaskEngine::takeWriteFailures()
+         */
+        void reportWriteFailures() {
+            size_t failures = engine.takeWriteFailures();
+            if (failures > 0) {
+                frame.append("\nError: ").append(failures)
+                     .append(" change(s) could not be saved to the task files.\n");
+            }
+        }
+
+        /**
+         * @brief Displays the current page of one category's tasks with a title and color formatting.
          *
-         * @return A `std::vector<T>` containing tasks for the specified date.
+         * This function formats a list of tasks with a given title into the frame, applying color
+         * formatting to the title text using ANSI escape codes. If no tasks are available, it
+         * formats "No tasks". Only the tasks on the current page are formatted, each with its
+         * number among all of the category's tasks; a footer tells which part of the list is shown
+         * when the tasks do not fit on one page.
          *
-         * @throws std::ios_base::failure If there is an error opening the file.
+         * @tparam T The type of tasks to display (StudyTask, LifeTask or WorkTask).
          *
-         * @see Task
-         * @see getTodayDate()
-         * @see loadFromStream()
+         * @param repository The tasks, read under the engine's shared lock.
+         * @param title The title to display above the task list.
+         * @param tasks References to the tasks of all categories; only those of type `T` are shown.
+         * @param color The color code for the title text (e.g., 31 for red, 32 for green).
          */
         template <typename T>
-        std::vector<T> loadTasks(const std::string& filePath, const std::string& date) {
-                static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
-
-                std::ifstream file(filePath);
-                std::vector<T> tasks;
-
-                if (!file.is_open()) {
-                    std::cerr << "Error: Could not open file: " << filePath << "\n";
-                    return tasks;
+        void displayTasks(const TaskRepository& repository, std::string_view title,
+                          const std::vector<TaskRef>& tasks, int color) {
+            frame.setColor(color).append("----- ").append(title).append(" -----\n\n").resetColor();
+
+            const TaskTable<T>& table = repository.getTasks<T>();
+            size_t first = page * PAGE_SIZE;
+            size_t total = 0;
+            size_t shown = 0;
+            for (const TaskRef& task : tasks) {
+                if (task.category != T::CATEGORY) {
+                    continue;
                 }
-
-                std::string line;
-                
-                while (std::getline(file, line)) {
-                    T task;
-                    std::istringstream ss(line);
-                    
-                    if (task.loadFromStream(ss) && trim_left(task.getWhenToDo()) == getTodayDate()) {
-                        tasks.push_back(task);
-                    }
+                if (total >= first && shown < PAGE_SIZE) {
+                    frame.append(total + 1).append(". ");
+                    table.get(task.id).render(frame);
+                    frame.append('\n');
+                    ++shown;
+                }
+                ++total;
             }
 
-            return tasks;
+            if (total == 0) {
+                frame.append("No tasks.\n");
+            } else if (shown == 0) {
+                frame.append("No more tasks on this page (").append(total).append(" in total).\n");
+            } else if (total > PAGE_SIZE) {
+                frame.append("Showing ").append(first + 1).append('-').append(first + shown)
+                     .append(" of ").append(total).append(" tasks.\n");
+            }
         }
 
         /**
-         * @brief Trims leading spaces from a string.
+         * @brief Displays the most urgent tasks of all categories.
          *
-         * This function removes any leading spaces (whitespace characters) from the input string.
-         * It finds the first non-space character and returns a substring starting from that character.
-         * If the string contains only spaces, it returns an empty string.
+         * The tasks are ordered by deadline, then by priority (highest first), then by
+         * when-to-do date, and only the first `AGENDA_SIZE` tasks are shown.
          *
-         * @param str The string to be trimmed.
-         *
-         * @return A `std::string` with leading spaces removed. If the input string consists only of spaces,
-         *         an empty string is returned.
-         *
-         * @note This function only removes spaces from the beginning of the string.
+         * @see TaskEngine::getAgenda()
          */
-        std::string trim_left(const std::string& str) {
-            size_t start = str.find_first_not_of(' ');
-            return (start == std::string::npos) ? "" : str.substr(start);
+        void displayAgenda() {
+            std::vector<Agenda::Entry> entries = engine.getAgenda(AGENDA_SIZE);
+            frame.append("\n----- Agenda -----\n\n");
+            if (entries.empty()) {
+                frame.append("No tasks.\n");
+            }
+
+            engine.read([this, &entries](const TaskRepository& repository) {
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    const TaskRef& task = entries[i].task;
+                    frame.append(i + 1).append(". ");
+                    switch (task.category) {
+                        case TaskCategory::Study:
+                            frame.append("Study task for ").append(entries[i].whenToDo).append('\n');
+                            repository.getTasks<StudyTask>().get(task.id).render(frame);
+                            break;
+                        case TaskCategory::Life:
+                            frame.append("Life task for ").append(entries[i].whenToDo).append('\n');
+                            repository.getTasks<LifeTask>().get(task.id).render(frame);
+                            break;
+                        case TaskCategory::Work:
+                            frame.append("Work task for ").append(entries[i].whenToDo).append('\n');
+                            repository.getTasks<WorkTask>().get(task.id).render(frame);
+                            break;
+                    }
+                    frame.append('\n');
+                }
+            });
+            frame.flush();
         }
 
         /**
-         * @brief Resets the console text color to the default.
+         * @brief Asks for search words and displays the tasks of all days containing all of them.
          *
-         * This function resets the text color of the console to its default color by sending
-         * the appropriate ANSI escape sequence. It is typically used to clear any custom text
-         * color formatting applied in previous console output.
+         * The description, the subject of study tasks and the assignee of work tasks are
+         * searched, ignoring case; a word ending in `*` matches every word starting with it. The
+         * first `SEARCH_RESULTS` matches are shown together with their date.
          *
-         * @note This function assumes that the console supports ANSI escape codes for text color formatting.
+         * @see TaskEngine::search()
          */
-        void resetColor() {
-            std::cout << "\033[0m";
+        void searchTasks() {
+            std::string query;
+            std::cout << "Search for (end a word with * to match its beginning): ";
+            std::cin.ignore();
+            std::getline(std::cin, query);
+
+            std::vector<TaskRef> matches = engine.search(query);
+            frame.append("\n----- Search results -----\n\n");
+            if (matches.empty()) {
+                frame.append("No tasks.\n");
+            }
+
+            engine.read([this, &matches](const TaskRepository& repository) {
+                size_t shown = std::min(matches.size(), SEARCH_RESULTS);
+                for (size_t i = 0; i < shown; ++i) {
+                    const TaskRef& task = matches[i];
+                    frame.append(i + 1).append(". ");
+                    switch (task.category) {
+                        case TaskCategory::Study:
+                            displayMatch(repository.getTasks<StudyTask>(), "Study", task.id);
+                            break;
+                        case TaskCategory::Life:
+                            displayMatch(repository.getTasks<LifeTask>(), "Life", task.id);
+                            break;
+                        case TaskCategory::Work:
+                            displayMatch(repository.getTasks<WorkTask>(), "Work", task.id);
+                            break;
+                    }
+                }
+                if (matches.size() > shown) {
+                    frame.append("Showing ").append(shown).append(" of ").append(matches.size())
+                         .append(" matching tasks.\n");
+                }
+            });
+            frame.flush();
         }
 
         /**
-         * @brief Displays a list of tasks with a title and color formatting.
-         *
-         * This function displays a list of tasks with a given title, applying color formatting
-         * to the title text using ANSI escape codes. If no tasks are available, it prints "No tasks".
-         * For each task, it prints its index and the task itself. The tasks are displayed in the order
-         * they appear in the provided vector.
-         *
-         * @tparam Task The type of tasks in the vector. This function works with any task type that
-         *              supports streaming (i.e., can be printed using `std::cout`).
+         * @brief Formats one search match with its category and date.
          *
-         * @param title The title to display above the task list.
-         * @param tasks The vector of tasks to be displayed.
-         * @param color The color code for the title text (e.g., 31 for red, 32 for green).
-         *
-         * @note The function uses ANSI escape codes to apply color formatting to the title.
-         *       The `resetColor` function is called after displaying the title to reset the text color.
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param table The tasks of the match's category.
+         * @param category The name of the category.
+         * @param id The id of the match.
          */
-        template <typename Task>
-        void displayTasks(const std::string& title, const std::vector<Task>& tasks, int color) {
-            std::cout << "\033[" << color << "m";
-            std::cout << "----- " << title << " -----\n\n";
-            resetColor();
-
-            if (tasks.empty()) {
-                std::cout << "No tasks.\n";
-            } else {
-                for (size_t i = 0; i < tasks.size(); ++i) {
-                    std::cout << i + 1 << ". " << tasks[i] << "\n";
-                }
-            }
+        template <typename T>
+        void displayMatch(const TaskTable<T>& table, std::string_view category, TaskId id) {
+            frame.append(category).append(" task for ").append(table.getWhenToDo(id)).append('\n');
+            table.get(id).render(frame);
+            frame.append('\n');
         }
 
         /**
@@ -260,7 +426,7 @@ namespace am {
          * @note If the user enters an invalid task type, an error message is displayed.
          */
         void addTaskForToday() {
-            std::string today = getTodayDate();
+            Date today = clock.today();
             std::cout << "Adding a task for today (" << today << ").\n";
 
             int type = chooseTaskType();
@@ -309,70 +475,68 @@ namespace am {
          *
          * This function allows the user to select a task type (Study, Life, or Work) 
          * and presents a list of tasks of the chosen type. The user can then choose a 
-         * task to mark as done. The selected task is removed from the corresponding 
-         * task file, and the updated list is saved back to the file.
+         * task to mark as done. The selected task is removed through the engine, which
+         * records the removal in the task journal.
          * 
          * - Prompts the user to choose a task type.
          * - Displays a list of tasks for the selected type.
          * - Allows the user to select a task by its number.
-         * - Removes the selected task from the file.
+         * - Removes the selected task from the repository and its file.
          * - Displays a confirmation message once the task is marked as done.
          *
          * @note If no tasks are available or the user enters an invalid task number, 
          *       an appropriate message is shown and the operation is aborted. 
-         *       The task files are updated accordingly after a task is removed.
          */
         void markTaskAsDone() {
             int type = chooseTaskType();
 
-            std::string filePath;
             switch (type) {
                 case 1:
-                    filePath = StudyTask::FILE_PATH;
+                    markTaskAsDone<StudyTask>();
                     break;
                 case 2:
-                    filePath = LifeTask::FILE_PATH;
+                    markTaskAsDone<LifeTask>();
                     break;
                 case 3:
-                    filePath = WorkTask::FILE_PATH;
+                    markTaskAsDone<WorkTask>();
                     break;
             }
+        }
 
-            std::ifstream file(filePath);
-            if (!file) {
-                std::cout << "No tasks of this type.\n";
-                return;
-            }
-
-            std::vector<std::string> lines;
-            std::string line;
-            while (std::getline(file, line)) {
-                lines.push_back(line);
-            }
-            file.close();
-
-            if (lines.empty()) {
+        /**
+         * @brief Lets the user pick one task of a category and removes it.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         */
+        template <typename T>
+        void markTaskAsDone() {
+            std::vector<TaskId> ids = engine.read([this](const TaskRepository& repository) {
+                const TaskTable<T>& tasks = repository.getTasks<T>();
+                std::vector<TaskId> live = tasks.liveIds();
+                frame.append("Select the task to mark as done:\n");
+                for (size_t i = 0; i < live.size(); ++i) {
+                    frame.append(i + 1).append(". ").append(tasks.get(live[i]).toFileString());
+                }
+                return live;
+            });
+            if (ids.empty()) {
+                frame.clear();
                 std::cout << "No tasks to mark as done.\n";
                 return;
             }
+            frame.flush();
 
-            std::cout << "Select the task to mark as done:\n";
-            for (size_t i = 0; i < lines.size(); ++i) {
-                std::cout << i + 1 << ". " << lines[i] << "\n";
-            }
-
-            int taskNumber;
+            size_t taskNumber;
             while (true) {
                 std::cout << "Enter task number: ";
                 std::cin >> taskNumber;
-                if (taskNumber > 0 && taskNumber <= lines.size()) break;
+                if (taskNumber > 0 && taskNumber <= ids.size()) break;
                 std::cout << "Invalid task number.\n";
             }
 
-            lines.erase(lines.begin() + taskNumber - 1);
-            std::ofstream outFile(filePath);
-            for (const auto& l : lines) {
-                outFile << l << "\n";
+            if (!engine.completeTask<T>(ids[taskNumber - 1])) {
+                std::cout << "The task could not be marked as done.\n";
+                return;
             }
             std::cout << "Task marked as done and removed from the list.\n";
         }
@@ -382,79 +546,22 @@ namespace am {
          *
          * This function retrieves today's date and calculates the next day's date.
          * It then reschedules any unfinished tasks (Study, Life, Work) by updating 
-         * their due dates to the next day.
+         * their due dates to the next day through the engine.
          *
-         * @note After rescheduling, a confirmation message is displayed.
+         * @note After rescheduling, a confirmation message is displayed, or an error if the
+         *       changes could not be written.
          */
         void rescheduleUnfinishedTasks() {
-            std::string today = getTodayDate();
-            std::string nextDay = getNextDay(today);
-
-            rescheduleTasks<StudyTask>(StudyTask::FILE_PATH, today, nextDay);
-            rescheduleTasks<LifeTask>(LifeTask::FILE_PATH, today, nextDay);
-            rescheduleTasks<WorkTask>(WorkTask::FILE_PATH, today, nextDay);
-
-            std::cout << "Rescheduled tasks for tomorrow!" << std::endl;
-        }
-
-        /**
-         * @brief Returns the next day's date.
-         *
-         * This function takes today's date as input, calculates the next day's date, 
-         * and returns it as a string in the format "dd.mm.yyyy".
-         *
-         * @param today The current date in "dd.mm.yyyy" format.
-         * @return The next day's date in "dd.mm.yyyy" format.
-         */
-        std::string getNextDay(const std::string& today) {
-            tm date = {};
-            strptime(today.c_str(), "%d.%m.%Y", &date);
-            time_t t = mktime(&date) + 86400;
-            tm* nextDay = localtime(&t);
-
-            char buf[11];
-            strftime(buf, sizeof(buf), "%d.%m.%Y", nextDay);
-            return std::string(buf);
-        }
-
-        /**
-         * @brief Reschedules tasks from today to the next day.
-         *
-         * This function loads tasks from a specified file, checks if their due date is today, 
-         * and reschedules them by updating their due date to the next day. The tasks are then 
-         * saved back to the file with the updated due dates.
-         *
-         * @tparam T The type of task to reschedule (must derive from Task).
-         * @param filePath The file path where the tasks are stored.
-         * @param today The current date in "dd.mm.yyyy" format.
-         * @param nextDay The next day's date in "dd.mm.yyyy" format.
-         */
-        template <typename T>
-        void rescheduleTasks(const std::string& filePath, const std::string& today, const std::string& nextDay) {
-            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
-
-            std::ifstream file(filePath);
-            std::vector<T> tasks;
-
-            if (!file.is_open()) {
-                std::cerr << "Error: Could not open file: " << filePath << "\n";
-            }
+            Date today = clock.today();
+            Date nextDay = today.nextDay();
 
-            std::string line;
-            while (std::getline(file, line)) {
-                T task;
-                std::istringstream ss(line);
-                if (task.loadFromStream(ss) && trim_left(task.getWhenToDo()) == today) {
-                    task.setWhenToDo(nextDay);
-                }
-                tasks.push_back(task);
+            size_t moved = 0;
+            if (!engine.rescheduleTasks(today, nextDay, moved)) {
+                std::cout << "Error: The rescheduled tasks could not be saved.\n";
+                return;
             }
-            file.close();
 
-            std::ofstream outFile(filePath);
-            for (const auto& task : tasks) {
-                outFile << task.toFileString();
-            }
+            std::cout << "Rescheduled tasks for tomorrow!\n";
         }
 
         /**
@@ -470,20 +577,20 @@ namespace am {
             short type = 0;
 
             while (true) {
-                std::cout << "\nWhat type of task?" << std::endl;
-                std::cout << "1 - Study" << std::endl;
-                std::cout << "2 - Life" << std::endl;
-                std::cout << "3 - Work" << std::endl;
-                std::cout << "4 - Exit" << std::endl;
+                std::cout << "\nWhat type of task?\n";
+                std::cout << "1 - Study\n";
+                std::cout << "2 - Life\n";
+                std::cout << "3 - Work\n";
+                std::cout << "4 - Exit\n";
 
                 std::cout << "Choose an option: ";
                 std::cin >> type;
 
                 if (type == 4) {
-                    std::cout << "Exiting task creation..." << std::endl;
+                    std::cout << "Exiting task creation...\n";
                     break;
                 } else if (type < 1 || type > 4) {
-                    std::cout << "Invalid option. Please choose between 1 and 4." << std::endl;
+                    std::cout << "Invalid option. Please choose between 1 and 4.\n";
                     continue;
                 }
 
@@ -514,33 +621,28 @@ namespace am {
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
         void createStudyTask() {
-            std::string description, when_to_do, deadline, priority, subject;
+            std::string description, subject;
 
             std::cout << "Provide description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "When do you want to do it? (DD.MM.YYYY): ";
-            std::getline(std::cin, when_to_do);
+            Date when_to_do = readDate();
 
             std::cout << "What is your deadline? (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "What is the priority? (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             std::cout << "What subject? ";
-            std::getline(std::cin, subject);
+            subject = readText();
 
             StudyTask studyTask(description, when_to_do, deadline, priority, subject);
             
-            std::ofstream outFile(StudyTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << studyTask.toFileString();
-                outFile.close();
+            if (engine.addTask(studyTask)) {
                 std::cout << "Study task added to file for: " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -555,33 +657,28 @@ namespace am {
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
         void createWorkTask() {
-            std::string description, when_to_do, deadline, priority, assignedBy;
+            std::string description, assignedBy;
 
             std::cout << "Provide description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "When do you want to do it? (DD.MM.YYYY): ";
-            std::getline(std::cin, when_to_do);
+            Date when_to_do = readDate();
 
             std::cout << "What is your deadline? (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "What is the priority? (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             std::cout << "Who is the assignee? ";
-            std::getline(std::cin, assignedBy);
+            assignedBy = readText();
 
             WorkTask workTask(description, when_to_do, deadline, priority, assignedBy);
             
-            std::ofstream outFile(WorkTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << workTask.toFileString();
-                outFile.close();
+            if (engine.addTask(workTask)) {
                 std::cout << "Work task added to file for : " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -595,30 +692,25 @@ namespace am {
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
         void createLifeTask() {
-            std::string description, when_to_do, deadline, priority;
+            std::string description;
 
             std::cout << "Provide description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "When do you want to do it? (DD.MM.YYYY): ";
-            std::getline(std::cin, when_to_do);
+            Date when_to_do = readDate();
 
             std::cout << "What is your deadline? (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "What is the priority? (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             LifeTask lifeTask(description, when_to_do, deadline, priority);
 
-            std::ofstream outFile(LifeTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << lifeTask.toFileString();
-                outFile.close();
+            if (engine.addTask(lifeTask)) {
                 std::cout << "Life task added to file for: " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -630,34 +722,29 @@ namespace am {
          * with the provided data and appends it to the relevant file for storage. 
          * The task is associated with the specified date (`when_to_do`).
          *
-         * @param when_to_do The date the task is scheduled to be done (format: DD.MM.YYYY).
+         * @param when_to_do The date the task is scheduled to be done.
          * 
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
-        void createStudyTask(const std::string& when_to_do) {
-            std::string description, deadline, priority, subject;
+        void createStudyTask(Date when_to_do) {
+            std::string description, subject;
 
             std::cout << "Enter task description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "Enter deadline date (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "Enter priority (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             std::cout << "What subject? ";
-            std::getline(std::cin, subject);
+            subject = readText();
 
             StudyTask studyTask(description, when_to_do, deadline, priority, subject);
-            std::ofstream outFile(StudyTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << studyTask.toFileString();
-                outFile.close();
+            if (engine.addTask(studyTask)) {
                 std::cout << "Study task added to file for today: " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -669,31 +756,26 @@ namespace am {
          * the provided data and appends it to the relevant file for storage. 
          * The task is associated with the specified date (`when_to_do`).
          *
-         * @param when_to_do The date the task is scheduled to be done (format: DD.MM.YYYY).
+         * @param when_to_do The date the task is scheduled to be done.
          * 
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
-        void createLifeTask(const std::string& when_to_do) {
-            std::string description, deadline, priority;
+        void createLifeTask(Date when_to_do) {
+            std::string description;
 
             std::cout << "Enter task description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "Enter deadline date (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "Enter priority (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             LifeTask lifeTask(description, when_to_do, deadline, priority);
-            std::ofstream outFile(LifeTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << lifeTask.toFileString();
-                outFile.close();
+            if (engine.addTask(lifeTask)) {
                 std::cout << "Life task added to file for today: " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -705,35 +787,30 @@ namespace am {
          * with the provided data and appends it to the relevant file for storage. 
          * The task is associated with the specified date (`when_to_do`).
          *
-         * @param when_to_do The date the task is scheduled to be done (format: DD.MM.YYYY).
+         * @param when_to_do The date the task is scheduled to be done.
          * 
          * @note If the file cannot be opened for writing, an error message is displayed.
          */
-        void createWorkTask(const std::string& when_to_do) {
-            std::string description, deadline, priority, assignedBy;
+        void createWorkTask(Date when_to_do) {
+            std::string description, assignedBy;
 
             std::cout << "Enter task description: ";
             std::cin.ignore();
-            std::getline(std::cin, description);
+            description = readText();
 
             std::cout << "Enter deadline date (DD.MM.YYYY): ";
-            std::getline(std::cin, deadline);
+            Date deadline = readDate();
 
             std::cout << "Enter priority (low, medium, high): ";
-            std::getline(std::cin, priority);
+            Priority priority = readPriority();
 
             std::cout << "Who is the assignee? ";
-            std::getline(std::cin, assignedBy);
+            assignedBy = readText();
 
             WorkTask workTask(description, when_to_do, deadline, priority, assignedBy);
 
-            std::ofstream outFile(WorkTask::FILE_PATH, std::ios::app);
-            if (outFile.is_open()) {
-                outFile << workTask.toFileString();
-                outFile.close();
+            if (engine.addTask(workTask)) {
                 std::cout << "Work task added to file for today: " << when_to_do << "\n";
-            } else {
-                std::cerr << "Error: Unable to open file for writing.\n";
             }
         }
 
@@ -0,0 +1,334 @@
+#ifndef TASK_SNAPSHOT_HPP
+#define TASK_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "DateIndex.hpp"
+#include "MappedFile.hpp"
+#include "TaskCategory.hpp"
+#include "TaskStorage.hpp"
+#include "TaskTable.hpp"
+
+namespace am {
+    /**
+     * @class TaskSnapshot
+     * @brief Versioned binary copy of one category file that loads without parsing.
+     *
+     * A snapshot starts with a fixed-size header holding the file magic, the layout version,
+     * the category, the record count and the signature of the text file it was made from. The
+     * header is followed by packed columns in the layout of `TaskTable`: when-to-do dates,
+     * deadlines, lines, label symbols and priorities, then an offset table into one blob with
+     * all descriptions and a second one into the distinct subjects or assignees. Loading is a
+     * single `mmap` and a copy of each column.
+     *
+     * A snapshot is only used while its text file is unchanged; the text files stay the source
+     * of truth. Numbers are stored in the byte order of the machine that wrote them, which the
+     * magic number rejects on a machine of the other order.
+     */
+    class TaskSnapshot {
+    public:
+        /** @brief File magic "AMTS". */
+        static constexpr uint32_t MAGIC = 0x53544D41;
+
+        /** @brief Version of the snapshot layout. */
+        static constexpr uint32_t VERSION = 1;
+
+        /**
+         * @brief Returns the snapshot path that belongs to a category file.
+         *
+         * @param textPath The path of the category file, e.g. "study.txt".
+         * @return The path with the ".txt" extension replaced by ".snap", e.g. "study.snap".
+         */
+        static std::string pathFor(const std::string& textPath) {
+            const std::string extension = ".txt";
+            if (textPath.size() > extension.size() &&
+                textPath.compare(textPath.size() - extension.size(), extension.size(), extension) == 0) {
+                return textPath.substr(0, textPath.size() - extension.size()) + ".snap";
+            }
+            return textPath + ".snap";
+        }
+
+        /**
+         * @brief Writes the live tasks of a table to a snapshot.
+         *
+         * The snapshot is written to a temporary file that replaces `filePath` once complete, so
+         * a reader never sees a half-written snapshot. A table with rejected lines is not
+         * saved, since the snapshot would stand in for a file without them.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param filePath The path of the snapshot.
+         * @param tasks The tasks to store.
+         * @param source The signature of the text file the tasks were read from.
+         * @return True if the snapshot was written, false otherwise.
+         */
+        template <typename T>
+        static bool save(const std::string& filePath, const TaskTable<T>& tasks,
+                         const DateIndex::FileSignature& source) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+            if (!tasks.getRejectedLines().empty()) {
+                return false;
+            }
+
+            std::vector<TaskId> ids = tasks.liveIds();
+            const uint32_t rows = static_cast<uint32_t>(ids.size());
+
+            std::vector<int32_t> whenToDo(rows), deadlines(rows);
+            std::vector<uint32_t> lines(rows), labels(rows), descriptionOffsets(rows + 1);
+            std::vector<uint8_t> priorities(rows);
+            std::vector<uint32_t> labelOffsets(1, 0);
+            std::unordered_map<std::string_view, uint32_t> labelSymbols;
+            std::string descriptionBlob, labelBlob;
+
+            for (uint32_t row = 0; row < rows; ++row) {
+                TaskId id = ids[row];
+                whenToDo[row] = tasks.getWhenToDo(id).toDays();
+                deadlines[row] = tasks.getDeadline(id).toDays();
+                lines[row] = tasks.getLine(id);
+                priorities[row] = static_cast<uint8_t>(tasks.getPriority(id));
+
+                std::string_view label = tasks.getLabel(id);
+                auto inserted = labelSymbols.emplace(label, static_cast<uint32_t>(labelSymbols.size()));
+                if (inserted.second) {
+                    labelBlob.append(label.data(), label.size());
+                    labelOffsets.push_back(static_cast<uint32_t>(labelBlob.size()));
+                }
+                labels[row] = inserted.first->second;
+
+                descriptionOffsets[row] = static_cast<uint32_t>(descriptionBlob.size());
+                descriptionBlob.append(tasks.getDescription(id));
+            }
+            descriptionOffsets[rows] = static_cast<uint32_t>(descriptionBlob.size());
+            if (descriptionBlob.size() > UINT32_MAX || labelBlob.size() > UINT32_MAX) {
+                std::cerr << "Error: Too much text for a snapshot: " << filePath << "\n";
+                return false;
+            }
+
+            Header header{};
+            header.magic = MAGIC;
+            header.version = VERSION;
+            header.category = static_cast<uint8_t>(T::CATEGORY);
+            header.rows = rows;
+            header.lineCount = tasks.getLineCount();
+            header.labels = static_cast<uint32_t>(labelSymbols.size());
+            header.descriptionBytes = descriptionBlob.size();
+            header.labelBytes = labelBlob.size();
+            header.sourceSize = source.size;
+            header.sourceModified = source.modified;
+
+            std::string buffer;
+            buffer.reserve(fileSize(header));
+            appendBytes(buffer, &header, sizeof(header));
+            appendColumn(buffer, whenToDo);
+            appendColumn(buffer, deadlines);
+            appendColumn(buffer, lines);
+            appendColumn(buffer, labels);
+            appendColumn(buffer, priorities);
+            appendColumn(buffer, descriptionOffsets);
+            appendColumn(buffer, labelOffsets);
+            appendBytes(buffer, descriptionBlob.data(), descriptionBlob.size());
+            appendBytes(buffer, labelBlob.data(), labelBlob.size());
+
+            std::string temporary = TaskStorage::temporaryPath(filePath);
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file.is_open() || !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                    std::cerr << "Error: Unable to write snapshot: " << filePath << "\n";
+                    std::remove(temporary.c_str());
+                    return false;
+                }
+            }
+            return TaskStorage::replaceFile(temporary, filePath);
+        }
+
+        /**
+         * @brief Adds the tasks stored in a snapshot to a table.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param filePath The path of the snapshot.
+         * @param tasks The table the tasks are added to; it should be empty.
+         * @param source The current signature of the text file, or null to accept the snapshot
+         *        whatever file it was made from.
+         * @return True if the snapshot was loaded, false if it is missing, stale or corrupt.
+         */
+        template <typename T>
+        static bool load(const std::string& filePath, TaskTable<T>& tasks,
+                         const DateIndex::FileSignature* source = nullptr) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            MappedFile file;
+            if (!file.open(filePath) || file.data().size() < sizeof(Header)) {
+                return false;
+            }
+
+            std::string_view data = file.data();
+            Header header;
+            std::memcpy(&header, data.data(), sizeof(header));
+            if (header.magic != MAGIC || header.version != VERSION ||
+                header.category != static_cast<uint8_t>(T::CATEGORY) || fileSize(header) != data.size()) {
+                return false;
+            }
+            if (source != nullptr && (header.sourceSize != source->size || header.sourceModified != source->modified)) {
+                return false;
+            }
+
+            const uint32_t rows = header.rows;
+            const char* position = data.data() + sizeof(Header);
+            std::vector<int32_t> whenToDo = readColumn<int32_t>(position, rows);
+            std::vector<int32_t> deadlines = readColumn<int32_t>(position, rows);
+            std::vector<uint32_t> lines = readColumn<uint32_t>(position, rows);
+            std::vector<uint32_t> labels = readColumn<uint32_t>(position, rows);
+            std::vector<uint8_t> priorities = readColumn<uint8_t>(position, rows);
+            std::vector<uint32_t> descriptionOffsets = readColumn<uint32_t>(position, rows + 1);
+            std::vector<uint32_t> labelOffsets = readColumn<uint32_t>(position, header.labels + 1);
+            std::string_view descriptionBlob(position, header.descriptionBytes);
+            std::string_view labelBlob(position + header.descriptionBytes, header.labelBytes);
+
+            if (!isValidOffsetTable(descriptionOffsets, descriptionBlob.size()) ||
+                !isValidOffsetTable(labelOffsets, labelBlob.size())) {
+                return false;
+            }
+
+            std::vector<StringInterner::Symbol> symbols(header.labels);
+            for (uint32_t label = 0; label < header.labels; ++label) {
+                symbols[label] = tasks.internLabel(
+                    labelBlob.substr(labelOffsets[label], labelOffsets[label + 1] - labelOffsets[label]));
+            }
+
+            tasks.reserve(tasks.capacity() + rows);
+            for (uint32_t row = 0; row < rows; ++row) {
+                if (labels[row] >= header.labels || priorities[row] >= PRIORITY_COUNT ||
+                    (row > 0 && lines[row] <= lines[row - 1])) {
+                    tasks.clear();
+                    return false;
+                }
+                tasks.addRow(
+                    descriptionBlob.substr(descriptionOffsets[row], descriptionOffsets[row + 1] - descriptionOffsets[row]),
+                    symbols[labels[row]], Date::fromDays(whenToDo[row]), Date::fromDays(deadlines[row]),
+                    static_cast<Priority>(priorities[row]), lines[row]);
+            }
+            tasks.setLineCount(header.lineCount);
+            return true;
+        }
+
+        /**
+         * @brief Builds a snapshot from a category file.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param textPath The path of the category file.
+         * @param snapshotPath The path of the snapshot to write.
+         * @return True if the snapshot was written, false if the file could not be read or written.
+         */
+        template <typename T>
+        static bool importText(const std::string& textPath, const std::string& snapshotPath) {
+            DateIndex::FileSignature source = DateIndex::FileSignature::of(textPath);
+            TaskStorage storage;
+            TaskTable<T> tasks;
+            if (!storage.loadTasks(textPath, tasks)) {
+                std::cerr << "Error: Could not open file: " << textPath << "\n";
+                return false;
+            }
+            if (!tasks.getRejectedLines().empty()) {
+                std::cerr << "Error: " << textPath << " has lines that are not valid tasks; "
+                          << "fix them before building a snapshot.\n";
+                return false;
+            }
+            return save(snapshotPath, tasks, source);
+        }
+
+        /**
+         * @brief Rewrites a category file from a snapshot.
+         *
+         * The snapshot is rewritten as well, so it stays valid for the new file. No lock is
+         * taken and the task journal is left alone; `TaskRepository::restoreSnapshot` does both.
+         *
+         * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+         * @param snapshotPath The path of the snapshot.
+         * @param textPath The path of the category file to write.
+         * @return True if the file was written, false if the snapshot is unusable or on a write error.
+         */
+        template <typename T>
+        static bool exportText(const std::string& snapshotPath, const std::string& textPath) {
+            TaskStorage storage;
+            TaskTable<T> tasks;
+            if (!load(snapshotPath, tasks)) {
+                std::cerr << "Error: Could not read snapshot: " << snapshotPath << "\n";
+                return false;
+            }
+            if (!storage.saveTasks(textPath, tasks)) {
+                return false;
+            }
+            tasks.renumberLines();
+            return save(snapshotPath, tasks, DateIndex::FileSignature::of(textPath));
+        }
+
+    private:
+        /**
+         * @struct Header
+         * @brief The fixed-size start of a snapshot file.
+         */
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint8_t category;
+            uint8_t reserved[3];
+            uint32_t rows;
+            uint32_t lineCount;
+            uint32_t labels;
+            uint64_t descriptionBytes;
+            uint64_t labelBytes;
+            int64_t sourceSize;
+            int64_t sourceModified;
+        };
+
+        static_assert(sizeof(Header) == 56, "snapshot header layout changed");
+
+        static size_t fileSize(const Header& header) {
+            size_t rows = header.rows;
+            return sizeof(Header)
+                + rows * (2 * sizeof(int32_t) + 2 * sizeof(uint32_t) + sizeof(uint8_t))
+                + (rows + 1) * sizeof(uint32_t)
+                + (static_cast<size_t>(header.labels) + 1) * sizeof(uint32_t)
+                + header.descriptionBytes + header.labelBytes;
+        }
+
+        static void appendBytes(std::string& buffer, const void* data, size_t size) {
+            buffer.append(static_cast<const char*>(data), size);
+        }
+
+        template <typename Value>
+        static void appendColumn(std::string& buffer, const std::vector<Value>& column) {
+            appendBytes(buffer, column.data(), column.size() * sizeof(Value));
+        }
+
+        template <typename Value>
+        static std::vector<Value> readColumn(const char*& position, size_t count) {
+            // The mapping gives no alignment guarantee for columns after the byte-sized ones.
+            std::vector<Value> column(count);
+            std::memcpy(column.data(), position, count * sizeof(Value));
+            position += count * sizeof(Value);
+            return column;
+        }
+
+        static bool isValidOffsetTable(const std::vector<uint32_t>& offsets, size_t blobSize) {
+            if (offsets.front() != 0 || offsets.back() != blobSize) {
+                return false;
+            }
+            for (size_t i = 1; i < offsets.size(); ++i) {
+                if (offsets[i] < offsets[i - 1]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef TASK_STORAGE_HPP
+#define TASK_STORAGE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <unistd.h>
+#include "Task.hpp"
+#include "MappedFile.hpp"
+#include "RecordReader.hpp"
+#include "TaskTable.hpp"
+#include "ThreadPool.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @class TaskStorage
+     * @brief Persistence layer for the task files (study.txt, life.txt, work.txt).
+     *
+     * This class reads a whole category file into memory and writes a whole category back.
+     * New records are appended by `TaskAppender` and changes are logged by `TaskJournal`.
+     * The in-memory state itself is kept by `TaskRepository`.
+     */
+    class TaskStorage {
+    public:
+
+        /** @brief Files smaller than this are parsed as a single chunk. */
+        static constexpr size_t MIN_CHUNK_BYTES = 1024 * 1024;
+
+        /**
+         * @class PendingLoad
+         * @brief A file being parsed in chunks on a thread pool, started by `startLoad`.
+         *
+         * The object keeps the file mapped until every chunk is parsed, and waits for the
+         * remaining chunks if it is destroyed before `finishLoad` was called.
+         *
+         * @tparam T The type of task being loaded.
+         */
+        template <typename T>
+        class PendingLoad {
+        public:
+            PendingLoad() = default;
+            PendingLoad(PendingLoad&&) = default;
+            PendingLoad& operator=(PendingLoad&&) = default;
+
+            /**
+             * @brief Returns the size of the file being parsed.
+             *
+             * @return The number of bytes the load covers.
+             */
+            size_t size() const {
+                return bytes;
+            }
+
+            ~PendingLoad() {
+                for (auto& chunk : chunks) {
+                    if (chunk.valid()) {
+                        chunk.wait();
+                    }
+                }
+            }
+
+        private:
+            friend class TaskStorage;
+
+            /** @brief The mapped file the chunks are parsed from. */
+            MappedFile file;
+
+            /** @brief Whether the file could be opened. */
+            bool opened = false;
+
+            /** @brief The size of the file when it was mapped. */
+            size_t bytes = 0;
+
+            /** @brief The parsed chunks in file order. */
+            std::vector<std::future<TaskTable<T>>> chunks;
+        };
+
+        /**
+         * @brief Loads every valid task stored in a file.
+         *
+         * The file is memory-mapped and tokenized in place by `RecordReader`, and every record
+         * is handed to `loadFromFields` as a set of `std::string_view` fields. Lines that cannot
+         * be parsed are skipped but still counted, so every task keeps the line number of its
+         * record. A missing file is treated as an empty category.
+         *
+         * @tparam T The type of task to load. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file containing the task data.
+         * @param tasks The table the loaded tasks are added to.
+         *
+         * @return True if the file was read, false if it could not be opened.
+         */
+        template <typename T>
+        bool loadTasks(const std::string& filePath, TaskTable<T>& tasks) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            MappedFile file;
+            if (!file.open(filePath)) {
+                return false;
+            }
+
+            TaskTable<T> parsed = parseChunk<T>(file.data());
+            tasks.merge(parsed, tasks.getLineCount());
+            return true;
+        }
+
+        /**
+         * @brief Loads every valid task stored in a file, parsing it in parallel.
+         *
+         * @tparam T The type of task to load. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file containing the task data.
+         * @param tasks The table the loaded tasks are added to.
+         * @param pool The threads the chunks of the file are parsed on.
+         *
+         * @return True if the file was read, false if it could not be opened.
+         */
+        template <typename T>
+        bool loadTasks(const std::string& filePath, TaskTable<T>& tasks, ThreadPool& pool) {
+            PendingLoad<T> load = startLoad<T>(filePath, pool);
+            return finishLoad(load, tasks);
+        }
+
+        /**
+         * @brief Starts parsing a file on a thread pool.
+         *
+         * The file is split into line-aligned chunks, one per worker for large files, and every
+         * chunk is parsed into its own table. Starting the loads of several files before
+         * finishing any of them parses the files concurrently.
+         *
+         * @tparam T The type of task to load. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file containing the task data.
+         * @param pool The threads the chunks are parsed on.
+         *
+         * @return The running load, to be passed to `finishLoad`.
+         */
+        template <typename T>
+        PendingLoad<T> startLoad(const std::string& filePath, ThreadPool& pool) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            PendingLoad<T> load;
+            load.opened = load.file.open(filePath);
+            if (!load.opened) {
+                return load;
+            }
+
+            std::string_view text = load.file.data();
+            load.bytes = text.size();
+            size_t chunkCount = std::max<size_t>(1, std::min(pool.size(), text.size() / MIN_CHUNK_BYTES));
+            size_t begin = 0;
+            for (size_t chunk = 1; chunk <= chunkCount && begin < text.size(); ++chunk) {
+                size_t end = text.size();
+                if (chunk < chunkCount) {
+                    end = text.find('\n', std::max(begin, text.size() * chunk / chunkCount));
+                    end = end == std::string_view::npos ? text.size() : end + 1;
+                }
+
+                std::string_view part = text.substr(begin, end - begin);
+                load.chunks.push_back(pool.submit([part] { return parseChunk<T>(part); }));
+                begin = end;
+            }
+            return load;
+        }
+
+        /**
+         * @brief Waits for a load started by `startLoad` and adds the tasks to a table.
+         *
+         * @tparam T The type of task being loaded.
+         *
+         * @param load The running load.
+         * @param tasks The table the loaded tasks are added to, in file order.
+         *
+         * @return True if the file was read, false if it could not be opened.
+         */
+        template <typename T>
+        bool finishLoad(PendingLoad<T>& load, TaskTable<T>& tasks) {
+            uint32_t line = tasks.getLineCount();
+            for (auto& chunk : load.chunks) {
+                TaskTable<T> parsed = chunk.get();
+                uint32_t lines = parsed.getLineCount();
+                tasks.merge(parsed, line);
+                line += lines;
+            }
+            load.chunks.clear();
+            load.file.close();
+            return load.opened;
+        }
+
+        /**
+         * @brief Loads the records appended to a file since it was last read.
+         *
+         * Only complete lines are read; a record still being written by another process is left
+         * for the next call. The new tasks are stored on the lines following the table's last line.
+         *
+         * @tparam T The type of task to load. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file containing the task data.
+         * @param tasks The table the new tasks are added to.
+         * @param offset The number of bytes already read; advanced past the lines read.
+         *
+         * @return False if the file is shorter than `offset`, i.e. it was replaced, or if the
+         *         line before `offset` was cut off by a concurrent write; true otherwise.
+         */
+        template <typename T>
+        bool loadAppended(const std::string& filePath, TaskTable<T>& tasks, size_t& offset) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            MappedFile file;
+            if (!file.open(filePath)) {
+                return offset == 0;
+            }
+            std::string_view text = file.data();
+            if (text.size() < offset) {
+                return false;
+            }
+
+            size_t end = text.rfind('\n');
+            if (end == std::string_view::npos || end < offset) {
+                return true;
+            }
+            size_t begin = offset;
+            if (begin > 0 && text[begin - 1] != '\n') {
+                // An appender terminates a last line that had no newline before adding its
+                // records; anything else means the last line was read while it was being written.
+                if (text[begin] != '\n') {
+                    return false;
+                }
+                ++begin;
+            }
+
+            if (begin <= end) {
+                TaskTable<T> parsed = parseChunk<T>(text.substr(begin, end - begin + 1));
+                tasks.merge(parsed, tasks.getLineCount());
+            }
+            offset = end + 1;
+            return true;
+        }
+
+        /**
+         * @brief Writes a task file with the given tasks, truncating it first.
+         *
+         * @tparam T The type of task to save. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file to write.
+         * @param tasks The tasks to write; removed tasks are skipped, rejected lines are kept.
+         *
+         * @return True if the file was written, false otherwise.
+         */
+        template <typename T>
+        bool writeTasks(const std::string& filePath, const TaskTable<T>& tasks) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            std::ofstream outFile(filePath, std::ios::trunc);
+            if (!outFile.is_open()) {
+                std::cerr << "Error: Unable to open file for writing: " << filePath << "\n";
+                return false;
+            }
+            formatTasks(outFile, tasks);
+            return static_cast<bool>(outFile);
+        }
+
+        /**
+         * @brief Writes the content of a task file with the given tasks to a stream.
+         *
+         * @tparam T The type of task to format. It must derive from the `Task` class.
+         *
+         * @param out The stream to write to.
+         * @param tasks The tasks to write; removed tasks are skipped, rejected lines are kept.
+         */
+        template <typename T>
+        static void formatTasks(std::ostream& out, const TaskTable<T>& tasks) {
+            static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+            // Rejected lines are written back where they were, between the tasks around them.
+            const auto& rejected = tasks.getRejectedLines();
+            size_t next = 0;
+            for (size_t row = 0; row < tasks.capacity(); ++row) {
+                TaskId id = static_cast<TaskId>(row);
+                while (next < rejected.size() && rejected[next].line < tasks.getLine(id)) {
+                    out << rejected[next++].text << '\n';
+                }
+                if (tasks.contains(id)) {
+                    out << tasks.get(id).toFileString();
+                }
+            }
+            while (next < rejected.size()) {
+                out << rejected[next++].text << '\n';
+            }
+        }
+
+        /**
+         * @brief Replaces a task file with the given tasks.
+         *
+         * The tasks are written to a temporary file that is renamed over `filePath`, so readers
+         * see either the old or the new file, never a partly written one, and never wait for
+         * the rewrite.
+         *
+         * @tparam T The type of task to save. It must derive from the `Task` class.
+         *
+         * @param filePath The path to the file to overwrite.
+         * @param tasks The tasks to write; removed tasks are skipped, rejected lines are kept.
+         *
+         * @return True if the file was replaced, false otherwise.
+         */
+        template <typename T>
+        bool saveTasks(const std::string& filePath, const TaskTable<T>& tasks) {
+            std::string temporary = temporaryPath(filePath);
+            if (!writeTasks(temporary, tasks) || !replaceFile(temporary, filePath)) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Replaces a file with the given text, like `saveTasks` does.
+         *
+         * @param filePath The path to the file to overwrite.
+         * @param text The new content of the file.
+         *
+         * @return True if the file was replaced, false otherwise.
+         */
+        static bool saveText(const std::string& filePath, const std::string& text) {
+            std::string temporary = temporaryPath(filePath);
+            std::ofstream outFile(temporary, std::ios::trunc | std::ios::binary);
+            if (!outFile.is_open()) {
+                std::cerr << "Error: Unable to open file for writing: " << temporary << "\n";
+                return false;
+            }
+            outFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+            outFile.close();
+            if (!outFile || !replaceFile(temporary, filePath)) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns a temporary path next to a file that is unique to this process.
+         *
+         * @param filePath The path of the file that will be replaced.
+         * @return The temporary path.
+         */
+        static std::string temporaryPath(const std::string& filePath) {
+            return filePath + ".tmp" + std::to_string(getpid());
+        }
+
+        /**
+         * @brief Atomically moves a fully written temporary file over a file.
+         *
+         * @param temporary The temporary file.
+         * @param filePath The file to replace.
+         * @return True if the file was replaced, false otherwise.
+         */
+        static bool replaceFile(const std::string& temporary, const std::string& filePath) {
+            if (std::rename(temporary.c_str(), filePath.c_str()) != 0) {
+                std::cerr << "Error: Unable to replace file: " << filePath << "\n";
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        template <typename T>
+        static TaskTable<T> parseChunk(std::string_view text) {
+            TaskTable<T> tasks;
+            RecordReader reader(text);
+            RecordFields fields;
+            T task;
+            uint32_t line = 0;
+            while (reader.next(fields)) {
+                if (task.loadFromFields(fields)) {
+                    tasks.add(task, line);
+                } else {
+                    tasks.addRejectedLine(line, reader.line());
+                }
+                ++line;
+            }
+            tasks.setLineCount(line);
+            return tasks;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,646 @@
+#ifndef TASK_TABLE_HPP
+#define TASK_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Date.hpp"
+#include "LifeTask.hpp"
+#include "Priority.hpp"
+#include "StringArena.hpp"
+#include "StudyTask.hpp"
+#include "Task.hpp"
+#include "TaskCategory.hpp"
+#include "WorkTask.hpp"
+using namespace am;
+
+namespace am {
+    /**
+     * @brief Access to the text field that only some task categories have.
+     *
+     * Study tasks have a subject and work tasks have an assignee. Both are stored in the
+     * label column of a `TaskTable`; life tasks leave it empty.
+     *
+     * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+     */
+    template <typename T>
+    struct TaskLabel;
+
+    template <>
+    struct TaskLabel<StudyTask> {
+        static const std::string& get(const StudyTask& task) {
+            return task.getSubject();
+        }
+
+        static void set(StudyTask& task, std::string_view label) {
+            task.setSubject(std::string(label));
+        }
+    };
+
+    template <>
+    struct TaskLabel<WorkTask> {
+        static const std::string& get(const WorkTask& task) {
+            return task.getAssignedBy();
+        }
+
+        static void set(WorkTask& task, std::string_view label) {
+            task.setAssignedBy(std::string(label));
+        }
+    };
+
+    template <>
+    struct TaskLabel<LifeTask> {
+        static std::string_view get(const LifeTask&) {
+            return std::string_view();
+        }
+
+        static void set(LifeTask&, std::string_view) {}
+    };
+
+    /**
+     * @class TaskTable
+     * @brief Column-oriented in-memory table of the tasks of one category, addressed by stable ids.
+     *
+     * Instead of one polymorphic object per task, every field is kept in its own dense column:
+     * the dates as 32-bit day counts, the priority as one byte and the text fields in a
+     * `StringArena` owned by the table. Subjects and assignees repeat on many rows and are
+     * interned, so each distinct value is stored once and a row only keeps its symbol. Scans
+     * such as "due today" or "high priority" read a single packed array, a task costs a few
+     * dozen bytes plus its description, and clearing the table frees all text in one go
+     * instead of string by string.
+     *
+     * A task's id is its row. Removed tasks are only marked as removed, so the ids of all other
+     * tasks stay valid for the rest of the session and can be kept in indexes. Every task also
+     * remembers the line of its record in the category file, which is how the task journal
+     * refers to it. Tasks changed through `update` stay marked as dirty until the repository
+     * has saved them, so only the changed records are written. Lines of the file that are not
+     * valid records are kept verbatim as rejected lines, so rewriting the file preserves them.
+     *
+     * @tparam T The type of task (StudyTask, LifeTask or WorkTask).
+     */
+    template <typename T>
+    class TaskTable {
+        static_assert(std::is_base_of<Task, T>::value, "T must derive from Task");
+
+    public:
+        /**
+         * @struct RejectedLine
+         * @brief A line of the category file that could not be read as a task.
+         */
+        struct RejectedLine {
+            /** @brief The zero-based line in the category file. */
+            uint32_t line;
+
+            /** @brief The line as it appears in the file, without its newline character. */
+            std::string_view text;
+        };
+
+        /**
+         * @brief Adds a task whose record is stored on a known line of the category file.
+         *
+         * Lines must be added in increasing order.
+         *
+         * @param task The task to add.
+         * @param line The zero-based line of the task's record.
+         * @return The id of the new task.
+         */
+        TaskId add(const T& task, uint32_t line) {
+            return addRow(task.getDescription(), internLabel(TaskLabel<T>::get(task)),
+                task.getWhenToDo(), task.getDeadline(), task.getPriority(), line);
+        }
+
+        /**
+         * @brief Adds a task from its field values without building a task object.
+         *
+         * Lines must be added in increasing order.
+         *
+         * @param description The description; it is copied into the table's arena.
+         * @param label The subject or assignee, as returned by `internLabel`.
+         * @param when The when-to-do date.
+         * @param deadline The deadline.
+         * @param priority The priority.
+         * @param line The zero-based line of the task's record.
+         * @return The id of the new task.
+         */
+        TaskId addRow(std::string_view description, StringInterner::Symbol label, Date when, Date deadline,
+                      Priority priority, uint32_t line) {
+            descriptions.push_back(arena.store(description));
+            labels.push_back(label);
+            whenToDo.push_back(when);
+            deadlines.push_back(deadline);
+            priorities.push_back(priority);
+            live.push_back(true);
+            lines.push_back(line);
+            ++liveTasks;
+            lineCount = std::max(lineCount, line + 1);
+            return static_cast<TaskId>(lines.size() - 1);
+        }
+
+        /**
+         * @brief Returns the symbol of a subject or assignee, storing it on first use.
+         *
+         * @param label The subject or assignee.
+         * @return The symbol to pass to `addRow`.
+         */
+        StringInterner::Symbol internLabel(std::string_view label) {
+            return labelNames.intern(label, arena);
+        }
+
+        /**
+         * @brief Adds a task whose record is appended as a new last line of the file.
+         *
+         * @param task The task to add.
+         * @return The id of the new task.
+         */
+        TaskId add(const T& task) {
+            return add(task, lineCount);
+        }
+
+        /**
+         * @brief Rebuilds a task object from its row.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return A copy of the task.
+         */
+        T get(TaskId id) const {
+            T task;
+            task.setDescription(std::string(getDescription(id)));
+            task.setWhenToDo(whenToDo[id]);
+            task.setDeadline(deadlines[id]);
+            task.setPriority(priorities[id]);
+            TaskLabel<T>::set(task, getLabel(id));
+            task.markClean();
+            return task;
+        }
+
+        /**
+         * @brief Replaces every field of a task and marks the task as dirty.
+         *
+         * The id and the line of the task's record stay the same.
+         *
+         * @param id The id of the task; it must be valid.
+         * @param task The new field values.
+         * @return True if the task was clean before, false if it already had unsaved changes.
+         */
+        bool update(TaskId id, const T& task) {
+            assign(id, task);
+            return markDirty(id);
+        }
+
+        /**
+         * @brief Replaces every field of a task with values that are already saved.
+         *
+         * @param id The id of the task; it must be valid.
+         * @param task The new field values.
+         */
+        void assign(TaskId id, const T& task) {
+            if (getDescription(id) != task.getDescription()) {
+                descriptions[id] = arena.store(task.getDescription());
+            }
+            labels[id] = labelNames.intern(TaskLabel<T>::get(task), arena);
+            whenToDo[id] = task.getWhenToDo();
+            deadlines[id] = task.getDeadline();
+            priorities[id] = task.getPriority();
+        }
+
+        /**
+         * @brief Marks a task as changed in memory but not yet saved.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return True if the task was clean before, false if it was already dirty.
+         */
+        bool markDirty(TaskId id) {
+            if (dirtyRows.size() <= id) {
+                dirtyRows.resize(lines.size());
+            }
+            if (dirtyRows[id]) {
+                return false;
+            }
+            dirtyRows[id] = true;
+            dirtyIds.push_back(id);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether a task has unsaved changes.
+         *
+         * @param id The id of the task.
+         * @return True if the task is dirty, false otherwise.
+         */
+        bool isDirty(TaskId id) const {
+            return id < dirtyRows.size() && dirtyRows[id];
+        }
+
+        /**
+         * @brief Returns the tasks with unsaved changes, in the order they were first changed.
+         *
+         * @return The ids of the dirty tasks; removed tasks may be among them.
+         */
+        const std::vector<TaskId>& getDirtyIds() const {
+            return dirtyIds;
+        }
+
+        /**
+         * @brief Marks one task as saved.
+         *
+         * @param id The id of the task.
+         */
+        void markClean(TaskId id) {
+            if (!isDirty(id)) {
+                return;
+            }
+            dirtyRows[id] = false;
+            dirtyIds.erase(std::find(dirtyIds.begin(), dirtyIds.end(), id));
+        }
+
+        /**
+         * @brief Marks every task as saved.
+         */
+        void clearDirty() {
+            for (TaskId id : dirtyIds) {
+                dirtyRows[id] = false;
+            }
+            dirtyIds.clear();
+        }
+
+        /**
+         * @brief Returns the description of a task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return A view into the table's arena, valid until the table is cleared.
+         */
+        std::string_view getDescription(TaskId id) const {
+            return descriptions[id];
+        }
+
+        /**
+         * @brief Returns the subject of a study task or the assignee of a work task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return A view into the table's arena, empty for life tasks.
+         */
+        std::string_view getLabel(TaskId id) const {
+            return labelNames.view(labels[id]);
+        }
+
+        /**
+         * @brief Returns the when-to-do date of a task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return The date.
+         */
+        Date getWhenToDo(TaskId id) const {
+            return whenToDo[id];
+        }
+
+        /**
+         * @brief Returns the deadline of a task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return The date.
+         */
+        Date getDeadline(TaskId id) const {
+            return deadlines[id];
+        }
+
+        /**
+         * @brief Returns the priority of a task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return The priority.
+         */
+        Priority getPriority(TaskId id) const {
+            return priorities[id];
+        }
+
+        /**
+         * @brief Changes the when-to-do date of a task.
+         *
+         * @param id The id of the task; it must be valid.
+         * @param date The new date.
+         */
+        void setWhenToDo(TaskId id, Date date) {
+            whenToDo[id] = date;
+        }
+
+        /**
+         * @brief Returns the live tasks scheduled for a date by scanning the when-to-do column.
+         *
+         * @param date The date to look for.
+         * @return The ids of the matching tasks, in row order.
+         */
+        std::vector<TaskId> selectByWhenToDo(Date date) const {
+            std::vector<TaskId> ids;
+            for (size_t id = 0; id < whenToDo.size(); ++id) {
+                if (whenToDo[id] == date && live[id]) {
+                    ids.push_back(static_cast<TaskId>(id));
+                }
+            }
+            return ids;
+        }
+
+        /**
+         * @brief Returns the live tasks with one of the given priorities by scanning the priority column.
+         *
+         * @param mask The accepted priorities, combined from `priorityMask` values.
+         * @return The ids of the matching tasks, in row order.
+         */
+        std::vector<TaskId> selectByPriority(uint8_t mask) const {
+            std::vector<TaskId> ids;
+            for (size_t id = 0; id < priorities.size(); ++id) {
+                if ((mask >> static_cast<unsigned>(priorities[id])) & live[id]) {
+                    ids.push_back(static_cast<TaskId>(id));
+                }
+            }
+            return ids;
+        }
+
+        /**
+         * @brief Returns the line of a task's record in the category file.
+         *
+         * @param id The id of the task; it must be valid.
+         * @return The zero-based line number.
+         */
+        uint32_t getLine(TaskId id) const {
+            return lines[id];
+        }
+
+        /**
+         * @brief Finds the task stored on a line of the category file.
+         *
+         * @param line The zero-based line number.
+         * @param id Receives the id of the task on success.
+         * @return True if a live task is stored on that line, false otherwise.
+         */
+        bool findByLine(uint32_t line, TaskId& id) const {
+            // Removed tasks may share a line number with the next live task, so skip over them.
+            for (auto found = std::lower_bound(lines.begin(), lines.end(), line);
+                 found != lines.end() && *found == line; ++found) {
+                id = static_cast<TaskId>(found - lines.begin());
+                if (live[id]) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Keeps a line of the category file that is not a valid record.
+         *
+         * Lines must be added in increasing order.
+         *
+         * @param line The zero-based line.
+         * @param text The line as read; it is copied into the table's arena.
+         */
+        void addRejectedLine(uint32_t line, std::string_view text) {
+            rejectedLines.push_back(RejectedLine{line, arena.store(text)});
+            lineCount = std::max(lineCount, line + 1);
+        }
+
+        /**
+         * @brief Returns the lines of the category file that are not valid records.
+         *
+         * @return The rejected lines ordered by line.
+         */
+        const std::vector<RejectedLine>& getRejectedLines() const {
+            return rejectedLines;
+        }
+
+        /**
+         * @brief Returns the number of lines of the category file, including unparsable ones.
+         *
+         * @return The line the next appended record will be stored on.
+         */
+        uint32_t getLineCount() const {
+            return lineCount;
+        }
+
+        /**
+         * @brief Sets the number of lines of the category file.
+         *
+         * @param count The number of lines read from the file.
+         */
+        void setLineCount(uint32_t count) {
+            lineCount = std::max(lineCount, count);
+        }
+
+        /**
+         * @brief Updates the line numbers after the file was rewritten with the live tasks and
+         *        the rejected lines.
+         */
+        void renumberLines() {
+            uint32_t line = 0;
+            size_t rejected = 0;
+            for (size_t id = 0; id < lines.size(); ++id) {
+                while (rejected < rejectedLines.size() && rejectedLines[rejected].line < lines[id]) {
+                    rejectedLines[rejected++].line = line++;
+                }
+                // Removed tasks keep the number of the next line so the numbers stay sorted.
+                lines[id] = live[id] ? line++ : line;
+            }
+            while (rejected < rejectedLines.size()) {
+                rejectedLines[rejected++].line = line++;
+            }
+            lineCount = line;
+        }
+
+        /**
+         * @brief Marks a task as removed.
+         *
+         * @param id The id of the task.
+         * @return True if the task existed and was not removed yet, false otherwise.
+         */
+        bool remove(TaskId id) {
+            if (!contains(id)) {
+                return false;
+            }
+            live[id] = false;
+            --liveTasks;
+            return true;
+        }
+
+        /**
+         * @brief Checks whether an id refers to a task that has not been removed.
+         *
+         * @param id The id of the task.
+         * @return True if the task exists, false otherwise.
+         */
+        bool contains(TaskId id) const {
+            return id < lines.size() && live[id];
+        }
+
+        /**
+         * @brief Returns the ids of all tasks that have not been removed, in row order.
+         *
+         * @return The ids of the live tasks.
+         */
+        std::vector<TaskId> liveIds() const {
+            std::vector<TaskId> ids;
+            ids.reserve(liveTasks);
+            for (size_t id = 0; id < lines.size(); ++id) {
+                if (live[id]) {
+                    ids.push_back(static_cast<TaskId>(id));
+                }
+            }
+            return ids;
+        }
+
+        /**
+         * @brief Returns the number of tasks that have not been removed.
+         *
+         * @return The number of live tasks.
+         */
+        size_t size() const {
+            return liveTasks;
+        }
+
+        /**
+         * @brief Checks whether the table has no live tasks.
+         *
+         * @return True if every task was removed or none was added.
+         */
+        bool empty() const {
+            return liveTasks == 0;
+        }
+
+        /**
+         * @brief Returns the number of ids handed out so far, including removed tasks.
+         *
+         * @return One past the largest id.
+         */
+        size_t capacity() const {
+            return lines.size();
+        }
+
+        /**
+         * @brief Returns the number of bytes of text owned by the table.
+         *
+         * @return The bytes allocated by the table's arena.
+         */
+        size_t textBytes() const {
+            return arena.bytesAllocated();
+        }
+
+        /**
+         * @brief Reserves room for a number of rows.
+         *
+         * @param rows The expected number of tasks.
+         */
+        void reserve(size_t rows) {
+            descriptions.reserve(rows);
+            labels.reserve(rows);
+            whenToDo.reserve(rows);
+            deadlines.reserve(rows);
+            priorities.reserve(rows);
+            live.reserve(rows);
+            lines.reserve(rows);
+        }
+
+        /**
+         * @brief Moves all rows of another table to the end of this one.
+         *
+         * The text of the other table is taken over without copying it, so this is cheap even
+         * for large tables. It is used to combine the tables of a file parsed in chunks.
+         *
+         * @param other The table to take the rows from; it is left empty.
+         * @param lineOffset The line of this table's file on which line 0 of `other` is stored.
+         */
+        void merge(TaskTable& other, uint32_t lineOffset) {
+            arena.adopt(other.arena);
+
+            std::vector<StringInterner::Symbol> symbols(other.labelNames.size());
+            for (size_t symbol = 0; symbol < symbols.size(); ++symbol) {
+                symbols[symbol] = labelNames.intern(
+                    other.labelNames.view(static_cast<StringInterner::Symbol>(symbol)), arena);
+            }
+            for (StringInterner::Symbol label : other.labels) {
+                labels.push_back(symbols[label]);
+            }
+
+            descriptions.insert(descriptions.end(), other.descriptions.begin(), other.descriptions.end());
+            whenToDo.insert(whenToDo.end(), other.whenToDo.begin(), other.whenToDo.end());
+            deadlines.insert(deadlines.end(), other.deadlines.begin(), other.deadlines.end());
+            priorities.insert(priorities.end(), other.priorities.begin(), other.priorities.end());
+            live.insert(live.end(), other.live.begin(), other.live.end());
+            for (uint32_t line : other.lines) {
+                lines.push_back(line + lineOffset);
+            }
+            for (const RejectedLine& rejected : other.rejectedLines) {
+                rejectedLines.push_back(RejectedLine{rejected.line + lineOffset, rejected.text});
+            }
+
+            liveTasks += other.liveTasks;
+            lineCount = std::max(lineCount, other.lineCount + lineOffset);
+            other.clear();
+        }
+
+        /**
+         * @brief Removes all tasks and resets the ids.
+         */
+        void clear() {
+            descriptions.clear();
+            labels.clear();
+            whenToDo.clear();
+            deadlines.clear();
+            priorities.clear();
+            live.clear();
+            lines.clear();
+            dirtyRows.clear();
+            dirtyIds.clear();
+            rejectedLines.clear();
+            labelNames.clear();
+            arena.clear();
+            liveTasks = 0;
+            lineCount = 0;
+        }
+
+    private:
+        /** @brief Owner of the text of all fields of all tasks. */
+        StringArena arena;
+
+        /** @brief The distinct subjects or assignees. */
+        StringInterner labelNames;
+
+        /** @brief Description of every task. */
+        std::vector<std::string_view> descriptions;
+
+        /** @brief Subject or assignee of every task as a symbol of `labelNames`. */
+        std::vector<StringInterner::Symbol> labels;
+
+        /** @brief When-to-do date of every task. */
+        std::vector<Date> whenToDo;
+
+        /** @brief Deadline of every task. */
+        std::vector<Date> deadlines;
+
+        /** @brief Priority of every task. */
+        std::vector<Priority> priorities;
+
+        /** @brief Whether the task with the same id is still in the table. */
+        std::vector<bool> live;
+
+        /** @brief Line of every task's record in the category file. */
+        std::vector<uint32_t> lines;
+
+        /** @brief Whether the task with the same id has unsaved changes; grown on first use. */
+        std::vector<bool> dirtyRows;
+
+        /** @brief Ids of the dirty tasks, in the order they were first changed. */
+        std::vector<TaskId> dirtyIds;
+
+        /** @brief Lines of the category file that are not valid records, ordered by line. */
+        std::vector<RejectedLine> rejectedLines;
+
+        /** @brief Number of tasks that have not been removed. */
+        size_t liveTasks = 0;
+
+        /** @brief Number of lines in the category file. */
+        uint32_t lineCount = 0;
+    };
+}
+
+#endif
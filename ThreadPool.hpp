@@ -0,0 +1,132 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace am {
+    /**
+     * @class ThreadPool
+     * @brief Fixed set of worker threads running submitted jobs in submission order.
+     *
+     * Jobs are queued and picked up by the first idle worker; `submit` returns a future for the
+     * job's result. The destructor runs the remaining jobs and joins the workers.
+     */
+    class ThreadPool {
+    public:
+
+        /**
+         * @brief Starts a pool with the given number of worker threads.
+         *
+         * @param threads The number of workers; 0 uses one per hardware thread.
+         */
+        explicit ThreadPool(size_t threads = 0) {
+            if (threads == 0) {
+                threads = defaultThreadCount();
+            }
+            workers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { run(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Finishes all queued jobs and stops the workers.
+         */
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_all();
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Queues a job.
+         *
+         * @tparam Job A callable taking no arguments.
+         * @param job The job to run on a worker thread.
+         * @return A future for the job's result; it rethrows an exception thrown by the job.
+         */
+        template <typename Job>
+        std::future<typename std::invoke_result<Job>::type> submit(Job&& job) {
+            using Result = typename std::invoke_result<Job>::type;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+            std::future<Result> result = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobs.emplace([task] { (*task)(); });
+            }
+            ready.notify_one();
+            return result;
+        }
+
+        /**
+         * @brief Returns the number of worker threads.
+         *
+         * @return The size of the pool.
+         */
+        size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Returns the number of hardware threads, or 1 if it is unknown.
+         *
+         * @return The default pool size.
+         */
+        static size_t defaultThreadCount() {
+            unsigned count = std::thread::hardware_concurrency();
+            return count > 0 ? count : 1;
+        }
+
+    private:
+        /** @brief The worker threads. */
+        std::vector<std::thread> workers;
+
+        /** @brief Jobs waiting for a worker. */
+        std::queue<std::function<void()>> jobs;
+
+        /** @brief Protects `jobs` and `stopping`. */
+        std::mutex mutex;
+
+        /** @brief Signalled when a job is queued or the pool stops. */
+        std::condition_variable ready;
+
+        /** @brief Whether the workers should exit once the queue is empty. */
+        bool stopping = false;
+
+        void run() {
+            while (true) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this] { return stopping || !jobs.empty(); });
+                    if (jobs.empty()) {
+                        return;
+                    }
+                    job = std::move(jobs.front());
+                    jobs.pop();
+                }
+                job();
+            }
+        }
+    };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <string>
 #include <sstream>
 #include "Task.hpp"
+#include "TaskCategory.hpp"
 using namespace am;
 
 namespace am {
@@ -27,6 +28,12 @@ namespace am {
         /** @brief The file path to save the work tasks. */
         static const std::string FILE_PATH;
 
+        /** @brief The category the work tasks belong to. */
+        static constexpr TaskCategory CATEGORY = TaskCategory::Work;
+
+        /** @brief The number of comma-separated fields of a work task record. */
+        static constexpr size_t FIELD_COUNT = 5;
+
         /** 
          * @brief Default constructor for creating an empty WorkTask.
          * 
@@ -39,15 +46,15 @@ namespace am {
          * @brief Parameterized constructor for creating a WorkTask with given data.
          * 
          * @param description The description of the task.
-         * @param when_to_do The date when the task should be done (DD.MM.YYYY).
-         * @param deadline The deadline for the task (DD.MM.YYYY).
-         * @param priority The priority of the task (low, medium, high).
+         * @param when_to_do The date when the task should be done.
+         * @param deadline The deadline for the task.
+         * @param priority The priority of the task.
          * @param assignedBy The person who assigned the task.
          */
         WorkTask(const std::string& description,
-                const std::string when_to_do,
-                const std::string& deadline,
-                const std::string& priority,
+                Date when_to_do,
+                Date deadline,
+                Priority priority,
                 const std::string& assignedBy)
             : Task(description, when_to_do, deadline, priority), assignedBy(assignedBy) {}
 
@@ -78,22 +85,37 @@ namespace am {
         /** 
          * @brief Loads the task data from a stream (e.g., file or string).
          * 
+         * The next line of the stream is split by `RecordReader` and passed to `loadFromFields`.
+         * 
          * @param stream The input stream from which to read the task data.
          * @return True if the task data is successfully loaded, false otherwise.
          */
         bool loadFromStream(std::istringstream& stream) override {
-            std::getline(stream, assignedBy, ',');
-            std::getline(stream, description, ',');
-            std::getline(stream, when_to_do, ',');
-            std::getline(stream, deadline, ',');
-            std::getline(stream, priority, ',');
-                
+            std::string line;
+            std::getline(stream, line);
+
+            RecordFields fields;
+            RecordReader::splitLine(line, fields);
+            return loadFromFields(fields);
+        }
+
+        /** 
+         * @brief Loads the task data from tokenized fields.
+         * 
+         * @param fields The fields of one record (assignee, description, dates, priority).
+         * @return True if the task data is successfully loaded, false otherwise.
+         */
+        bool loadFromFields(const RecordFields& fields) override {
+            assignedBy.assign(fields[0]);
+            description.assign(fields[1]);
+            bool validDates = loadDatesFromFields(fields, 2);
+            bool validPriority = parsePriority(fields[4], priority);
+
             return !(
                 assignedBy.empty() || 
                 description.empty() || 
-                when_to_do.empty() || 
-                deadline.empty() || 
-                priority.empty());
+                !validDates || 
+                !validPriority);
         }
 
         /** 
@@ -102,7 +124,7 @@ namespace am {
          * @return A string representation of the task for file storage.
          */
         std::string toFileString() const override {
-            return assignedBy + ", " + description + ", " + when_to_do + ", " + deadline + ", " + priority + "\n";
+            return assignedBy + ", " + description + ", " + when_to_do.toString() + ", " + deadline.toString() + ", " + std::string(priorityName(priority)) + "\n";
         }
 
         const std::string& getAssignedBy() const {
@@ -111,6 +133,17 @@ namespace am {
 
         void setAssignedBy(const std::string& newAssignedBy) {
             assignedBy = newAssignedBy;
+            dirty = true;
+        }
+
+        /** 
+         * @brief Formats the task details for the console into a frame.
+         * 
+         * @param frame The frame the task details are appended to.
+         */
+        void render(Frame& frame) const override {
+            frame.append("  Assignee: ").append(assignedBy).append('\n');
+            renderCommon(frame);
         }
 
         /** 
@@ -121,16 +154,13 @@ namespace am {
          * @return The output stream with the task details.
          */
         friend std::ostream& operator<<(std::ostream& os, const WorkTask& task) {
-            os << "  Assignee: " << task.getAssignedBy() << "\n";
-            os << "  Description: " << task.getDescription() << "\n";
-            os << "  Deadline: " << task.getDeadline() << "\n";
-            os << "  Priority: " << task.getPriority() << "\n";
-            return os;
+            Frame frame;
+            task.render(frame);
+            std::string_view text = frame.view();
+            return os.write(text.data(), static_cast<std::streamsize>(text.size()));
         }
 
     };
-    /** @brief The file path for storing work tasks. */
-    const std::string WorkTask::FILE_PATH = "work.txt";
 }
 
 